@@ -11,6 +11,10 @@ let package = Package(
 			name: "ODBCKit",
 			targets: ["ODBCKit"]
 		),
+		.executable(
+			name: "ODBCKitBenchmarks",
+			targets: ["ODBCKitBenchmarks"]
+		),
 	],
 	dependencies: [
 		// Dependencies declare other packages that this package depends on.
@@ -34,9 +38,13 @@ let package = Package(
 			name: "ODBCKit",
 			dependencies: ["CNanODBC"]
 		),
+		.executableTarget(
+			name: "ODBCKitBenchmarks",
+			dependencies: ["CNanODBC", "ODBCKit"]
+		),
 		.testTarget(
 			name: "ODBCKitTests",
-			dependencies: ["ODBCKit"]
+			dependencies: ["ODBCKit", "CNanODBC"]
 		),
 	],
 	cLanguageStandard: .c11,
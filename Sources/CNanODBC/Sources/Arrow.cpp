@@ -0,0 +1,428 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <vector>
+
+// Exports results through the Arrow C data interface
+// (https://arrow.apache.org/docs/format/CDataInterface.html). Every record batch is one rowset of
+// the result. Fixed-width columns whose bound buffer already has the Arrow layout are handed off
+// without copying; all other columns are converted.
+
+namespace {
+	// Releases the children that have been handed a `release` callback, so that a schema or array
+	// that fails half way through being exported does not leak the children exported so far.
+	template <typename T> void releaseChildren(std::vector<T> & children) {
+		for (auto & child : children) {
+			if (child.release != NULL) { child.release(&child); }
+		}
+	}
+
+	struct SchemaData {
+		std::string format;
+		std::string name;
+		std::vector<ArrowSchema> children;
+		std::vector<ArrowSchema *> childPointers;
+
+		~SchemaData() { releaseChildren(children); }
+	};
+
+	struct ArrayData {
+		std::unique_ptr<char[]> released;
+		std::vector<uint8_t> validity;
+		std::vector<int32_t> offsets;
+		std::vector<char> values;
+		const void * buffers[3] = { NULL, NULL, NULL };
+		std::vector<ArrowArray> children;
+		std::vector<ArrowArray *> childPointers;
+
+		~ArrayData() { releaseChildren(children); }
+	};
+
+	struct StreamData {
+		explicit StreamData(const nanodbc::result & res) : res(res) {}
+
+		nanodbc::result res;
+		std::string lastError;
+	};
+
+	void releaseSchema(ArrowSchema * schema) {
+		if (schema->release == NULL) { return; }
+
+		delete static_cast<SchemaData *>(schema->private_data);
+		schema->release = NULL;
+	}
+
+	void releaseArray(ArrowArray * array) {
+		if (array->release == NULL) { return; }
+
+		delete static_cast<ArrayData *>(array->private_data);
+		array->release = NULL;
+	}
+
+	// The Arrow format string for the C type `auto_bind` chose for a column.
+	const char * arrowFormat(int cType) {
+		switch (cType) {
+			case SQL_C_SSHORT: return "s";
+			case SQL_C_USHORT: return "S";
+			case SQL_C_SLONG: return "i";
+			case SQL_C_ULONG: return "I";
+			case SQL_C_SBIGINT: return "l";
+			case SQL_C_UBIGINT: return "L";
+			case SQL_C_FLOAT: return "f";
+			case SQL_C_DOUBLE: return "g";
+			case SQL_C_DATE: return "tdD";
+			case SQL_C_TIME: return "tts";
+			case SQL_C_TIMESTAMP: return "tsu:";
+			case SQL_C_BINARY: return "z";
+			default: return "u";
+		}
+	}
+
+	// The size of a value of `cType` if its bound buffer can be handed to Arrow as is, 0 otherwise.
+	size_t fixedWidth(int cType) {
+		switch (cType) {
+			case SQL_C_SSHORT:
+			case SQL_C_USHORT: return 2;
+			case SQL_C_SLONG:
+			case SQL_C_ULONG:
+			case SQL_C_FLOAT: return 4;
+			case SQL_C_SBIGINT:
+			case SQL_C_UBIGINT:
+			case SQL_C_DOUBLE: return 8;
+			default: return 0;
+		}
+	}
+
+	template <typename T> void appendValue(std::vector<char> & values, T value) {
+		const char * bytes = reinterpret_cast<const char *>(&value);
+		values.insert(values.end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename T> T boundValue(const char * data, unsigned long length, long row) {
+		T value;
+		std::memcpy(&value, data + row * length, sizeof(T));
+		return value;
+	}
+
+	// Appends the value of `col` in the current row of `res` to `data`, converting it to the Arrow
+	// layout of `cType`. Returns `false` if the value is null.
+	bool appendConverted(nanodbc::result & res, short col, int cType, ArrayData & data) {
+		const char * bound = res.column_bound_data(col);
+		const unsigned long length = res.column_bound_length(col);
+		const long position = res.rowset_position();
+
+		if (bound != NULL && cType != SQL_C_WCHAR) {
+			const nanodbc::null_type indicator = res.column_bound_indicators(col)[position];
+			const bool isNull = indicator == SQL_NULL_DATA;
+
+			switch (cType) {
+				case SQL_C_DATE: {
+					const auto d = boundValue<nanodbc::date>(bound, length, position);
+					appendValue<int32_t>(data.values, isNull ? 0 : daysSinceEpoch(d.year, d.month, d.day));
+					break;
+				}
+				case SQL_C_TIME: {
+					const auto t = boundValue<nanodbc::time>(bound, length, position);
+					appendValue<int32_t>(data.values, isNull ? 0 : t.hour * 3600 + t.min * 60 + t.sec);
+					break;
+				}
+				case SQL_C_TIMESTAMP: {
+					const auto ts = boundValue<nanodbc::timestamp>(bound, length, position);
+					appendValue<int64_t>(data.values, isNull ? 0 : microsecondsSinceEpoch(ts));
+					break;
+				}
+				default: {
+					const char * begin = bound + position * length;
+					size_t size = 0;
+
+					if (!isNull && cType == SQL_C_BINARY) {
+						size = indicator == SQL_NO_TOTAL
+								   ? length
+								   : std::min<size_t>(static_cast<size_t>(indicator), length);
+					} else {
+						size = boundStringLength(begin, length, indicator);
+					}
+
+					data.values.insert(data.values.end(), begin, begin + size);
+					data.offsets.push_back(static_cast<int32_t>(data.values.size()));
+					break;
+				}
+			}
+
+			return !isNull;
+		}
+
+		// Unbound (long/blob) or wide character columns.
+		switch (cType) {
+			case SQL_C_SSHORT: appendValue(data.values, res.get<int16_t>(col, 0)); break;
+			case SQL_C_USHORT: appendValue(data.values, res.get<uint16_t>(col, 0)); break;
+			case SQL_C_SLONG: appendValue(data.values, res.get<int32_t>(col, 0)); break;
+			case SQL_C_ULONG: appendValue(data.values, res.get<uint32_t>(col, 0)); break;
+			case SQL_C_SBIGINT: appendValue(data.values, res.get<int64_t>(col, 0)); break;
+			case SQL_C_UBIGINT: appendValue(data.values, res.get<uint64_t>(col, 0)); break;
+			case SQL_C_FLOAT: appendValue(data.values, res.get<float>(col, 0)); break;
+			case SQL_C_DOUBLE: appendValue(data.values, res.get<double>(col, 0)); break;
+			case SQL_C_DATE: {
+				const auto d = res.get<nanodbc::date>(col, nanodbc::date { 1970, 1, 1 });
+				appendValue<int32_t>(data.values, daysSinceEpoch(d.year, d.month, d.day));
+				break;
+			}
+			case SQL_C_TIME: {
+				const auto t = res.get<nanodbc::time>(col, nanodbc::time { 0, 0, 0 });
+				appendValue<int32_t>(data.values, t.hour * 3600 + t.min * 60 + t.sec);
+				break;
+			}
+			case SQL_C_TIMESTAMP: {
+				const auto ts = res.get<nanodbc::timestamp>(
+					col, nanodbc::timestamp { 1970, 1, 1, 0, 0, 0, 0 });
+				appendValue<int64_t>(data.values, microsecondsSinceEpoch(ts));
+				break;
+			}
+			case SQL_C_BINARY: {
+				const auto value = res.get<std::vector<uint8_t>>(col, std::vector<uint8_t>());
+				data.values.insert(data.values.end(), value.begin(), value.end());
+				data.offsets.push_back(static_cast<int32_t>(data.values.size()));
+				break;
+			}
+			default: {
+				const auto value = res.get<std::string>(col, std::string());
+				data.values.insert(data.values.end(), value.begin(), value.end());
+				data.offsets.push_back(static_cast<int32_t>(data.values.size()));
+				break;
+			}
+		}
+
+		return !res.is_null(col);
+	}
+
+	void exportSchema(nanodbc::result & res, ArrowSchema * out) {
+		const short columns = res.columns();
+		std::unique_ptr<SchemaData> data(new SchemaData);
+		data->format = "+s";
+
+		// Zeroed, so the children that are not exported yet have no `release` callback.
+		data->children.resize(columns);
+		data->childPointers.resize(columns);
+
+		for (short i = 0; i < columns; i++) {
+			std::unique_ptr<SchemaData> childData(new SchemaData);
+			childData->format = arrowFormat(res.column_c_datatype(i));
+			childData->name = res.column_name(i);
+
+			data->children[i] = ArrowSchema { .format = childData->format.c_str(),
+											  .name = childData->name.c_str(),
+											  .metadata = NULL,
+											  .flags = ARROW_FLAG_NULLABLE,
+											  .n_children = 0,
+											  .children = NULL,
+											  .dictionary = NULL,
+											  .release = releaseSchema,
+											  .private_data = childData.release() };
+			data->childPointers[i] = &data->children[i];
+		}
+
+		*out = ArrowSchema { .format = data->format.c_str(),
+							 .name = data->name.c_str(),
+							 .metadata = NULL,
+							 .flags = 0,
+							 .n_children = columns,
+							 .children = data->childPointers.data(),
+							 .dictionary = NULL,
+							 .release = releaseSchema,
+							 .private_data = data.release() };
+	}
+
+	// Exports the rest of the current rowset of `res` (fetching the next rowset first if the
+	// current one has been consumed). Returns `false` at the end of the result.
+	bool exportBatch(nanodbc::result & res, ArrowArray * out) {
+		if (!res.next()) { return false; }
+
+		const short columns = res.columns();
+		const long first = res.rowset_position();
+		const long last = std::max(res.rows(), first + 1);
+		const long length = last - first;
+
+		std::vector<int> cTypes(columns);
+		std::vector<bool> zeroCopy(columns);
+		std::vector<int64_t> nullCounts(columns, 0);
+		std::vector<std::unique_ptr<ArrayData>> columnData(columns);
+
+		for (short i = 0; i < columns; i++) {
+			cTypes[i] = res.column_c_datatype(i);
+			zeroCopy[i] = fixedWidth(cTypes[i]) != 0 && res.column_bound_data(i) != NULL &&
+						  fixedWidth(cTypes[i]) == res.column_bound_length(i);
+			columnData[i].reset(new ArrayData);
+
+			if (!zeroCopy[i]) {
+				columnData[i]->validity.assign((length + 7) / 8, 0);
+				if (std::strcmp(arrowFormat(cTypes[i]), "u") == 0 ||
+					std::strcmp(arrowFormat(cTypes[i]), "z") == 0) {
+					columnData[i]->offsets.assign(1, 0);
+				}
+			}
+		}
+
+		// Walk the rowset in memory; `next` does not fetch while rows of the current rowset remain.
+		for (long row = first; row < last; row++) {
+			if (row != first) { res.next(); }
+
+			for (short i = 0; i < columns; i++) {
+				if (zeroCopy[i]) { continue; }
+
+				if (appendConverted(res, i, cTypes[i], *columnData[i])) {
+					const long bit = row - first;
+					columnData[i]->validity[bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+				} else {
+					nullCounts[i]++;
+				}
+			}
+		}
+
+		std::unique_ptr<ArrayData> data(new ArrayData);
+		data->children.resize(columns);
+		data->childPointers.resize(columns);
+
+		for (short i = 0; i < columns; i++) {
+			ArrayData & child = *columnData[i];
+			int64_t offset = 0;
+			int64_t buffers = 2;
+
+			if (zeroCopy[i]) {
+				// The bitmap covers the whole buffer, of which this batch starts at `first`.
+				const nanodbc::null_type * indicators = res.column_bound_indicators(i);
+				child.validity.assign((last + 7) / 8, 0);
+
+				for (long row = first; row < last; row++) {
+					if (indicators[row] == SQL_NULL_DATA) {
+						nullCounts[i]++;
+					} else {
+						child.validity[row / 8] |= static_cast<uint8_t>(1 << (row % 8));
+					}
+				}
+
+				child.released = res.release_bound_data(i);
+				child.buffers[1] = child.released.get();
+				offset = first;
+			} else if (!child.offsets.empty()) {
+				child.buffers[1] = child.offsets.data();
+				child.buffers[2] = child.values.data();
+				buffers = 3;
+			} else {
+				child.buffers[1] = child.values.data();
+			}
+
+			child.buffers[0] = nullCounts[i] == 0 ? NULL : child.validity.data();
+
+			data->children[i] = ArrowArray { .length = length,
+											 .null_count = nullCounts[i],
+											 .offset = offset,
+											 .n_buffers = buffers,
+											 .n_children = 0,
+											 .buffers = child.buffers,
+											 .children = NULL,
+											 .dictionary = NULL,
+											 .release = releaseArray,
+											 .private_data = columnData[i].release() };
+			data->childPointers[i] = &data->children[i];
+		}
+
+		data->buffers[0] = NULL;
+
+		*out = ArrowArray { .length = length,
+							.null_count = 0,
+							.offset = 0,
+							.n_buffers = 1,
+							.n_children = columns,
+							.buffers = data->buffers,
+							.children = data->childPointers.data(),
+							.dictionary = NULL,
+							.release = releaseArray,
+							.private_data = data.release() };
+
+		return true;
+	}
+
+	int streamGetSchema(ArrowArrayStream * stream, ArrowSchema * out) {
+		auto data = static_cast<StreamData *>(stream->private_data);
+
+		try {
+			exportSchema(data->res, out);
+			return 0;
+		} catch (std::exception & e) {
+			data->lastError = e.what();
+			return EIO;
+		}
+	}
+
+	int streamGetNext(ArrowArrayStream * stream, ArrowArray * out) {
+		auto data = static_cast<StreamData *>(stream->private_data);
+
+		try {
+			if (!exportBatch(data->res, out)) { out->release = NULL; }
+			return 0;
+		} catch (std::exception & e) {
+			data->lastError = e.what();
+			return EIO;
+		}
+	}
+
+	const char * streamGetLastError(ArrowArrayStream * stream) {
+		auto data = static_cast<StreamData *>(stream->private_data);
+		return data->lastError.empty() ? NULL : data->lastError.c_str();
+	}
+
+	void streamRelease(ArrowArrayStream * stream) {
+		if (stream->release == NULL) { return; }
+
+		delete static_cast<StreamData *>(stream->private_data);
+		stream->release = NULL;
+	}
+}
+
+extern "C" {
+	bool resultExportArrowSchema(
+		CResult * _Nonnull rawRes, struct ArrowSchema * _Nonnull out, CError * _Nonnull error) {
+		try {
+			exportSchema(*reinterpret_cast<nanodbc::result *>(rawRes), out);
+			return true;
+		} catch (...) {
+			setError(error);
+
+			return false;
+		}
+	}
+
+	bool resultExportArrowBatch(
+		CResult * _Nonnull rawRes, struct ArrowArray * _Nonnull out, CError * _Nonnull error) {
+		try {
+			return exportBatch(*reinterpret_cast<nanodbc::result *>(rawRes), out);
+		} catch (...) {
+			setError(error);
+
+			return false;
+		}
+	}
+
+	void resultExportArrowStream(CResult * _Nonnull rawRes, struct ArrowArrayStream * _Nonnull out) {
+		*out = ArrowArrayStream {
+			.get_schema = streamGetSchema,
+			.get_next = streamGetNext,
+			.get_last_error = streamGetLastError,
+			.release = streamRelease,
+			.private_data = new StreamData(*reinterpret_cast<nanodbc::result *>(rawRes))
+		};
+	}
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+// nanodbc's `async_execute`/`async_next` wait on a Windows event handle, which drivers on other
+// platforms cannot signal. Asynchronous calls are therefore the blocking calls run on I/O threads
+// of their own, so that the calling thread, typically one of Swift's cooperative threads, is free
+// to do other work until the completion is called.
+
+namespace {
+	class IOExecutor {
+	public:
+		void submit(std::function<void()> task) {
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+
+				// Only hand the task to an idle thread if one is certain to pick it up; a call queued
+				// behind a long running query would wait for it to finish.
+				if (idle > tasks.size()) {
+					tasks.push_back(std::move(task));
+					available.notify_one();
+					return;
+				}
+			}
+
+			try {
+				std::thread([this, task] {
+					task();
+					run();
+				}).detach();
+			} catch (std::system_error &) {
+				// Out of threads: block the caller rather than never completing.
+				task();
+			}
+		}
+
+	private:
+		// Runs queued tasks until none has arrived for `keepAlive`.
+		void run() {
+			std::unique_lock<std::mutex> lock(mutex);
+
+			for (;;) {
+				idle++;
+				const bool hasTask =
+					available.wait_for(lock, keepAlive, [this] { return !tasks.empty(); });
+				idle--;
+
+				if (!hasTask) { return; }
+
+				std::function<void()> task = std::move(tasks.front());
+				tasks.pop_front();
+
+				lock.unlock();
+				task();
+				lock.lock();
+			}
+		}
+
+		const std::chrono::seconds keepAlive { 30 };
+
+		std::mutex mutex;
+		std::condition_variable available;
+		std::deque<std::function<void()>> tasks;
+		size_t idle = 0;
+	};
+
+	// Never destroyed, as detached threads may still be using it while the process exits.
+	IOExecutor & executor() {
+		static IOExecutor * executor = new IOExecutor();
+		return *executor;
+	}
+
+	// The error record of the calling I/O thread if `error` holds an error, `NULL` otherwise.
+	const CError * failure(const CError * error) { return error->isValid ? error : NULL; }
+}
+
+extern "C" {
+	void justExecuteAsync(
+		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
+		long timeout, void * _Nullable context, CBoolCompletion _Nonnull completion) {
+		executor().submit([=, query = std::string(query)] {
+			CError * error = threadError();
+			justExecute(rawConn, query.c_str(), batchOperations, timeout, error);
+			completion(context, !error->isValid, failure(error));
+		});
+	}
+
+	void cExecuteAsync(
+		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
+		long rowsetSize, long timeout, void * _Nullable context,
+		CResultCompletion _Nonnull completion) {
+		executor().submit([=, query = std::string(query)] {
+			CError * error = threadError();
+			CResult * res =
+				cExecute(rawConn, query.c_str(), batchOperations, rowsetSize, timeout, error);
+			completion(context, res, failure(error));
+		});
+	}
+
+	void stmtExecuteAsync(
+		CStatement * _Nonnull rawStmt, long rowsetSize, long timeout, void * _Nullable context,
+		CResultCompletion _Nonnull completion) {
+		executor().submit([=] {
+			CError * error = threadError();
+			CResult * res = stmtExecute(rawStmt, rowsetSize, timeout, error);
+			completion(context, res, failure(error));
+		});
+	}
+
+	void resultNextAsync(
+		CResult * _Nonnull rawRes, void * _Nullable context, CBoolCompletion _Nonnull completion) {
+		const nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+
+		// The next row of the current rowset is already in memory.
+		if (res.rowset_position() + 1 < res.rows()) {
+			CError * error = threadError();
+			const bool moved = resultNext(rawRes, error);
+			completion(context, moved, failure(error));
+			return;
+		}
+
+		executor().submit([=] {
+			CError * error = threadError();
+			const bool moved = resultNext(rawRes, error);
+			completion(context, moved, failure(error));
+		});
+	}
+}
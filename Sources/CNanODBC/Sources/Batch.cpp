@@ -0,0 +1,270 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <algorithm>
+#include <cstring>
+#include <sql.h>
+#include <sqlext.h>
+#include <vector>
+
+namespace {
+	// Owns the storage that the `CBatch`/`CBatchColumn` handed to C point into, so a batch can be
+	// refilled without reallocating once its buffers have grown to the requested size.
+	struct BatchStorage : CBatch {
+		struct Column {
+			BatchColumnType type;
+			std::vector<int64_t> ints;
+			std::vector<double> doubles;
+			std::vector<CDate> dates;
+			std::vector<CTime> times;
+			std::vector<CTimeStamp> timeStamps;
+			std::vector<uint8_t> bytes;
+			std::vector<int64_t> offsets;
+			std::vector<uint8_t> validity;
+		};
+
+		std::vector<Column> storage;
+		std::vector<CBatchColumn> cColumns;
+	};
+
+	BatchColumnType batchColumnType(int cType) {
+		switch (cType) {
+			case SQL_C_SSHORT:
+			case SQL_C_USHORT:
+			case SQL_C_SLONG:
+			case SQL_C_ULONG:
+			case SQL_C_SBIGINT:
+			case SQL_C_UBIGINT: return int64Column;
+			case SQL_C_FLOAT:
+			case SQL_C_DOUBLE: return doubleColumn;
+			case SQL_C_DATE: return dateColumn;
+			case SQL_C_TIME: return timeColumn;
+			case SQL_C_TIMESTAMP: return timeStampColumn;
+			case SQL_C_BINARY: return binaryColumn;
+			default: return stringColumn;
+		}
+	}
+
+	template <typename T> T boundValue(const char * data, unsigned long length, long row) {
+		T value;
+		std::memcpy(&value, data + row * length, sizeof(T));
+		return value;
+	}
+
+	void appendBytes(BatchStorage::Column & column, const uint8_t * begin, size_t size) {
+		column.bytes.insert(column.bytes.end(), begin, begin + size);
+		column.offsets.push_back(static_cast<int64_t>(column.bytes.size()));
+	}
+
+	// Appends the value of `col` in the current row of `res` to `column`. Bound columns are read
+	// straight out of nanodbc's rowset buffers; unbound (long/blob) columns go through `get`, which
+	// calls `SQLGetData`.
+	void appendValue(
+		nanodbc::result & res, short col, int cType, BatchStorage::Column & column, long row) {
+		const char * data = res.column_bound_data(col);
+		const unsigned long length = res.column_bound_length(col);
+		const long position = res.rowset_position();
+		bool isNull = false;
+
+		if (data != nullptr && cType != SQL_C_WCHAR) {
+			const nanodbc::null_type indicator = res.column_bound_indicators(col)[position];
+			isNull = indicator == SQL_NULL_DATA;
+
+			switch (column.type) {
+				case int64Column: {
+					int64_t value = 0;
+					if (!isNull) {
+						switch (cType) {
+							case SQL_C_SSHORT:
+								value = boundValue<int16_t>(data, length, position);
+								break;
+							case SQL_C_USHORT:
+								value = boundValue<uint16_t>(data, length, position);
+								break;
+							case SQL_C_SLONG:
+								value = boundValue<int32_t>(data, length, position);
+								break;
+							case SQL_C_ULONG:
+								value = boundValue<uint32_t>(data, length, position);
+								break;
+							default: value = boundValue<int64_t>(data, length, position); break;
+						}
+					}
+					column.ints.push_back(value);
+					break;
+				}
+				case doubleColumn: {
+					double value = 0;
+					if (!isNull) {
+						value = cType == SQL_C_FLOAT ? boundValue<float>(data, length, position)
+													 : boundValue<double>(data, length, position);
+					}
+					column.doubles.push_back(value);
+					break;
+				}
+				case dateColumn: {
+					CDate value = { 0, 0, 0 };
+					if (!isNull) {
+						const auto d = boundValue<nanodbc::date>(data, length, position);
+						value = CDate { .month = d.month, .day = d.day, .year = d.year };
+					}
+					column.dates.push_back(value);
+					break;
+				}
+				case timeColumn: {
+					CTime value = { 0, 0, 0 };
+					if (!isNull) {
+						const auto t = boundValue<nanodbc::time>(data, length, position);
+						value = CTime { .hour = t.hour, .minute = t.min, .second = t.sec };
+					}
+					column.times.push_back(value);
+					break;
+				}
+				case timeStampColumn: {
+					CTimeStamp value = { { 0, 0, 0 }, 0, 0, 0, 0 };
+					if (!isNull) {
+						const auto ts = boundValue<nanodbc::timestamp>(data, length, position);
+						value = CTimeStamp {
+							.date = CDate { .month = ts.month, .day = ts.day, .year = ts.year },
+							.hour = ts.hour,
+							.minute = ts.min,
+							.second = ts.sec,
+							.fractionalSec = ts.fract
+						};
+					}
+					column.timeStamps.push_back(value);
+					break;
+				}
+				case binaryColumn: {
+					const auto begin = reinterpret_cast<const uint8_t *>(data + position * length);
+					size_t size = 0;
+					if (!isNull) {
+						size = indicator == SQL_NO_TOTAL
+								   ? length
+								   : std::min<size_t>(static_cast<size_t>(indicator), length);
+					}
+					appendBytes(column, begin, size);
+					break;
+				}
+				case stringColumn: {
+					const char * begin = data + position * length;
+					appendBytes(column, reinterpret_cast<const uint8_t *>(begin),
+								boundStringLength(begin, length, indicator));
+					break;
+				}
+			}
+		} else {
+			switch (column.type) {
+				case binaryColumn: {
+					const auto value = res.get<std::vector<uint8_t>>(col, std::vector<uint8_t>());
+					isNull = res.is_null(col);
+					appendBytes(column, value.data(), value.size());
+					break;
+				}
+				default: {
+					const auto value = res.get<std::string>(col, std::string());
+					isNull = res.is_null(col);
+					appendBytes(
+						column, reinterpret_cast<const uint8_t *>(value.data()), value.size());
+					break;
+				}
+			}
+		}
+
+		if (!isNull) { column.validity[row / 8] |= static_cast<uint8_t>(1 << (row % 8)); }
+	}
+}
+
+extern "C" {
+	CBatch * _Nullable resultFetchBatch(
+		CResult * _Nonnull rawRes, long maxRows, CBatch * _Nullable reuse,
+		CError * _Nonnull error) {
+		BatchStorage * batch = NULL;
+
+		try {
+			auto res = reinterpret_cast<nanodbc::result *>(rawRes);
+			const short columns = res->columns();
+			std::vector<int> cTypes(columns);
+
+			batch = reuse != NULL ? static_cast<BatchStorage *>(reuse) : new BatchStorage;
+			batch->storage.resize(columns);
+
+			for (short i = 0; i < columns; i++) {
+				BatchStorage::Column & column = batch->storage[i];
+				cTypes[i] = res->column_c_datatype(i);
+				column.type = batchColumnType(cTypes[i]);
+				column.ints.clear();
+				column.doubles.clear();
+				column.dates.clear();
+				column.times.clear();
+				column.timeStamps.clear();
+				column.bytes.clear();
+				column.offsets.assign(1, 0);
+				column.validity.assign((std::max(maxRows, 0L) + 7) / 8, 0);
+			}
+
+			long rows = 0;
+
+			while (rows < maxRows && res->next()) {
+				for (short i = 0; i < columns; i++) {
+					appendValue(*res, i, cTypes[i], batch->storage[i], rows);
+				}
+
+				rows++;
+			}
+
+			batch->cColumns.resize(columns);
+
+			for (short i = 0; i < columns; i++) {
+				BatchStorage::Column & column = batch->storage[i];
+				const void * values = NULL;
+				const int64_t * offsets = NULL;
+
+				switch (column.type) {
+					case int64Column: values = column.ints.data(); break;
+					case doubleColumn: values = column.doubles.data(); break;
+					case dateColumn: values = column.dates.data(); break;
+					case timeColumn: values = column.times.data(); break;
+					case timeStampColumn: values = column.timeStamps.data(); break;
+					case stringColumn:
+					case binaryColumn:
+						values = column.bytes.data();
+						offsets = column.offsets.data();
+						break;
+				}
+
+				batch->cColumns[i] = CBatchColumn { .type = column.type,
+													.values = values,
+													.offsets = offsets,
+													.validity = column.validity.data() };
+			}
+
+			batch->rowCount = rows;
+			batch->columnCount = columns;
+			batch->columns = batch->cColumns.data();
+
+			return batch;
+		} catch (...) { setError(error); }
+
+		if (reuse == NULL) { delete batch; }
+		return NULL;
+	}
+
+	void batchDestroy(CBatch * _Nonnull batch) { delete static_cast<BatchStorage *>(batch); }
+
+	BatchColumnType resultColumnBatchType(
+		CResult * _Nonnull rawRes, short column, CError * _Nonnull error) {
+		try {
+			const nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+			return batchColumnType(res.column_c_datatype(column));
+		} catch (...) { setError(error); }
+
+		return stringColumn;
+	}
+}
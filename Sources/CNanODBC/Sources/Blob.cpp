@@ -0,0 +1,76 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <cstring>
+#include <sql.h>
+#include <sqlext.h>
+
+namespace {
+	struct BlobHandle {
+		// Shares the state of the `CResult` it was opened from, which may be destroyed first.
+		nanodbc::result res;
+		short column;
+		bool finished = false;
+		bool isNull = false;
+		long long remaining = -1;
+	};
+
+	BlobHandle & handle(CBlob * rawBlob) { return *reinterpret_cast<BlobHandle *>(rawBlob); }
+}
+
+extern "C" {
+	CBlob * _Nullable resultOpenBlob(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CError * _Nonnull error) {
+		try {
+			nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+			const short column = colNum != NULL ? *colNum : res.column(charToString(colName));
+
+			if (res.is_bound(column)) {
+				throw nanodbc::programming_error(
+					"resultOpenBlob: column is bound; read it with resultGetBinary");
+			}
+
+			return reinterpret_cast<CBlob *>(new BlobHandle { res, column });
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	long resultReadBlob(
+		CBlob * _Nonnull rawBlob, void * _Nonnull buffer, unsigned long length,
+		CError * _Nonnull error) {
+		BlobHandle & blob = handle(rawBlob);
+
+		if (blob.finished || length == 0) { return 0; }
+
+		try {
+			size_t written = 0;
+			nanodbc::null_type indicator = SQL_NO_TOTAL;
+			const bool more = blob.res.get_data_chunk(blob.column, buffer, length, written, indicator);
+
+			blob.finished = !more;
+			blob.isNull = blob.isNull || indicator == SQL_NULL_DATA;
+			blob.remaining = indicator == SQL_NO_TOTAL || indicator == SQL_NULL_DATA
+								 ? (more ? -1 : 0)
+								 : static_cast<long long>(indicator) - static_cast<long long>(written);
+
+			return static_cast<long>(written);
+		} catch (...) { setError(error); }
+
+		blob.finished = true;
+		return -1;
+	}
+
+	bool blobIsNull(CBlob * _Nonnull blob) { return handle(blob).isNull; }
+
+	long long blobRemainingLength(CBlob * _Nonnull blob) { return handle(blob).remaining; }
+
+	void blobDestroy(CBlob * _Nonnull blob) { delete &handle(blob); }
+}
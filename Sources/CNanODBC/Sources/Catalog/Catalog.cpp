@@ -4,37 +4,57 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
-#include "../nanodbc.h"
+#include "Catalog.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
+#include <cstdlib>
 #include <cstring>
 
+typedef std::vector<std::string> Names;
+
+namespace {
+	// Copies `names` into one block that starts with the array of pointers to them.
+	char * _Nonnull * _Nonnull copyList(const Names & names, unsigned long * _Nonnull arraySize) {
+		size_t bytes = names.size() * sizeof(char *);
+		for (const auto & name : names) { bytes += name.size() + 1; }
+
+		// At least one byte, so that an empty list is not `NULL`.
+		char ** list = static_cast<char **>(malloc(bytes > 0 ? bytes : 1));
+		char * next = reinterpret_cast<char *>(list + names.size());
+
+		for (size_t i = 0; i < names.size(); i++) {
+			list[i] = next;
+			memcpy(next, names[i].c_str(), names[i].size() + 1);
+			next += names[i].size() + 1;
+		}
+
+		*arraySize = names.size();
+		return list;
+	}
+
+	std::shared_ptr<const Names> listNames(std::list<nanodbc::string> found) {
+		return std::make_shared<const Names>(found.begin(), found.end());
+	}
+}
+
+std::shared_ptr<MetadataCache> makeMetadataCache() { return std::make_shared<MetadataCache>(); }
+
 CCatalog * _Nonnull catalogCreate(CConnection * _Nonnull conn) {
-	auto cat = new nanodbc::catalog(*reinterpret_cast<nanodbc::connection *>(conn));
-	return reinterpret_cast<CCatalog *>(cat);
+	return new CCatalog(handle(conn));
 }
 
+void catalogDestroy(CCatalog * _Nonnull catalog) { delete catalog; }
+
 char * _Nonnull * _Nullable catalogListCatalogs(
 	CCatalog * _Nonnull catalog, unsigned long * _Nonnull arraySize, CError * _Nonnull error) {
 	try {
-		auto cat = reinterpret_cast<nanodbc::catalog *>(catalog);
-		auto catalogs = cat->list_catalogs();
-
-		unsigned long size = catalogs.size();
-		*arraySize = size;
-
-		char * _Nonnull * _Nonnull cStringArray = new char *[size];
+		auto catalogs = catalog->owner.metadata->lookup<Names>(
+			"catalogs", NULL, [=] { return listNames(catalog->catalog.list_catalogs()); });
 
-		auto i = 0;
+		return copyList(*catalogs, arraySize);
+	} catch (...) {
+		setError(error);
 
-		for (auto c : catalogs) {
-			cStringArray[i] = strdup(c.c_str());
-			i++;
-		}
-
-		return cStringArray;
-	} catch (nanodbc::database_error & e) {
-		*error = CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
 		return NULL;
 	}
 }
@@ -42,38 +62,30 @@ char * _Nonnull * _Nullable catalogListCatalogs(
 char * _Nonnull * _Nullable catalogListSchemas(
 	CCatalog * _Nonnull catalog, unsigned long * _Nonnull arraySize, CError * _Nonnull error) {
 	try {
-		auto cat = reinterpret_cast<nanodbc::catalog *>(catalog);
-		auto schemas = cat->list_schemas();
+		auto schemas = catalog->owner.metadata->lookup<Names>(
+			"schemas", NULL, [=] { return listNames(catalog->catalog.list_schemas()); });
 
-		unsigned long size = schemas.size();
-		*arraySize = size;
+		return copyList(*schemas, arraySize);
+	} catch (...) {
+		setError(error);
 
-		char * _Nonnull * _Nonnull cStringArray = new char *[size];
+		return NULL;
+	}
+}
 
-		auto i = 0;
+void catalogListDestroy(char * _Nonnull * _Nonnull list) { free(list); }
 
-		for (auto s : schemas) {
-			cStringArray[i] = strdup(s.c_str());
-			i++;
-		}
+// MARK: - Metadata Cache
 
-		return cStringArray;
-	} catch (nanodbc::database_error & e) {
-		*error = CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-		return NULL;
-	}
+void connectionSetMetadataCacheTTL(CConnection * _Nonnull conn, long milliseconds) {
+	handle(conn).metadata->setTTL(milliseconds);
 }
 
-CTables * _Nullable catalogFindTables(
-	const char * _Nonnull table, const char * _Nonnull type, const char * _Nonnull schema,
-	const char * _Nonnull catalog) {
-	return NULL;
+void connectionInvalidateMetadataCache(
+	CConnection * _Nonnull conn, const char * _Nullable table) {
+	handle(conn).metadata->invalidate(table);
 }
 
-CColumns * _Nullable catalogFindColumns(
-	CCatalog * _Nonnull catalogPointer, const char * _Nonnull column, const char * _Nonnull table,
-	const char * _Nonnull schema, const char * _Nonnull catalog) {
-	return reinterpret_cast<CColumns *>(
-		new nanodbc::catalog::columns(reinterpret_cast<nanodbc::catalog *>(catalogPointer)
-										  ->find_columns(column, table, schema, catalog)));
+CMetadataCacheStatistics connectionMetadataCacheStatistics(CConnection * _Nonnull conn) {
+	return handle(conn).metadata->statistics();
 }
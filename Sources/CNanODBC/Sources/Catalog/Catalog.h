@@ -0,0 +1,236 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#ifndef Catalog_h
+#define Catalog_h
+
+#include "../Handles.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CCatalog {
+	explicit CCatalog(ConnectionHandle & owner) : owner(owner), catalog(owner.conn) {}
+
+	ConnectionHandle & owner;
+	nanodbc::catalog catalog;
+};
+
+// The rows of a catalog lookup. The strings of all rows are kept in one block the rows point
+// into, so a lookup allocates twice however many rows it finds.
+template <typename Row>
+struct CatalogRows {
+	std::vector<Row> rows;
+	std::unique_ptr<char[]> strings;
+};
+
+// Reads the rows of a catalog lookup into `CatalogRows`.
+//
+// The strings are gathered in one buffer first, with the rows holding offsets into it, and only
+// pointed into their final block by `finish` once it no longer grows.
+template <typename Row>
+class CatalogRowsBuilder {
+public:
+	CatalogRowsBuilder() : rows(std::make_shared<CatalogRows<Row>>()) {}
+
+	// Adds a zeroed row and returns it.
+	Row & append() {
+		rows->rows.emplace_back();
+		return rows->rows.back();
+	}
+
+	// Sets the string `field` of the last row.
+	void set(const char * Row::*field, const nanodbc::string & value) {
+		rows->rows.back().*field = reinterpret_cast<const char *>(strings.size());
+		strings.append(value.c_str(), value.size() + 1);
+		fields.emplace_back(rows->rows.size() - 1, field);
+	}
+
+	std::shared_ptr<const CatalogRows<Row>> finish() {
+		rows->strings.reset(new char[strings.size()]);
+		memcpy(rows->strings.get(), strings.data(), strings.size());
+
+		for (const auto & field : fields) {
+			const char *& value = rows->rows[field.first].*field.second;
+			value = rows->strings.get() + reinterpret_cast<size_t>(value);
+		}
+
+		return rows;
+	}
+
+private:
+	std::shared_ptr<CatalogRows<Row>> rows;
+	std::string strings;
+	std::vector<std::pair<size_t, const char * Row::*>> fields;
+};
+
+// Keeps the rows of a lookup alive for as long as they are handed out, even if the cache has
+// dropped them since.
+template <typename Row>
+struct CatalogHandle {
+	explicit CatalogHandle(std::shared_ptr<const CatalogRows<Row>> rows) : rows(rows) {}
+
+	const std::shared_ptr<const CatalogRows<Row>> rows;
+
+	const Row * array(unsigned long * count) const {
+		*count = rows->rows.size();
+		return rows->rows.data();
+	}
+};
+
+struct CTables : CatalogHandle<CCatalogTable> {
+	using CatalogHandle::CatalogHandle;
+};
+
+struct CTablePrivileges : CatalogHandle<CCatalogTablePrivilege> {
+	using CatalogHandle::CatalogHandle;
+};
+
+struct CPrimaryKeys : CatalogHandle<CCatalogPrimaryKey> {
+	using CatalogHandle::CatalogHandle;
+};
+
+struct CProcedures : CatalogHandle<CCatalogProcedure> {
+	using CatalogHandle::CatalogHandle;
+};
+
+struct CProcedureColumns : CatalogHandle<CCatalogProcedureColumn> {
+	using CatalogHandle::CatalogHandle;
+};
+
+// Also a cursor over its rows, for the accessors of `Columns.cpp`.
+struct CColumns : CatalogHandle<CCatalogColumn> {
+	using CatalogHandle::CatalogHandle;
+
+	// The current row; `catalogColumnNext` has to be called before the first one.
+	long position = -1;
+
+	const CCatalogColumn & current() const { return rows->rows.at(position); }
+};
+
+// The key a lookup of `kind` with `arguments` is cached under. The arguments cannot contain NUL,
+// so joined with it they are unique.
+inline std::string lookupKey(const char * kind, std::initializer_list<const char *> arguments) {
+	std::string key(kind);
+
+	for (auto argument : arguments) {
+		key.push_back('\0');
+		key.append(argument);
+	}
+
+	return key;
+}
+
+// Catalog lookups of a connection, kept for `ttl` so that asking for the shape of the same
+// tables again does not run `SQLColumns` or `SQLTables` each time. Connections acquired from a
+// pool share the pool's cache, so it is guarded by `mutex`.
+//
+// Nothing is cached while `ttl` is 0. The cache does not notice schema changes; the entries of
+// an altered table have to be dropped with `invalidate`.
+struct MetadataCache {
+	typedef std::chrono::steady_clock Clock;
+
+	struct Entry {
+		Clock::time_point fetched;
+		std::shared_ptr<const void> value;
+		// The table argument of the lookup, or `NULL` if it does not look up tables.
+		std::unique_ptr<std::string> table;
+	};
+
+	std::mutex mutex;
+	std::chrono::milliseconds ttl { 0 };
+	long hits = 0;
+	long misses = 0;
+	std::unordered_map<std::string, Entry> entries;
+
+	// Returns the value cached under `key` if it is younger than `ttl`, or else what `fetch`
+	// returns, which is cached unless the cache is off. `fetch` runs without holding the lock, so
+	// threads that miss at the same time each run the lookup.
+	template <typename T>
+	std::shared_ptr<const T> lookup(
+		const std::string & key, const std::string * table,
+		const std::function<std::shared_ptr<const T>()> & fetch) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			auto i = entries.find(key);
+
+			if (i != entries.end() && Clock::now() - i->second.fetched < ttl) {
+				hits++;
+				return std::static_pointer_cast<const T>(i->second.value);
+			}
+
+			misses++;
+		}
+
+		std::shared_ptr<const T> value = fetch();
+
+		std::lock_guard<std::mutex> guard(mutex);
+
+		if (ttl.count() > 0) {
+			expire();
+
+			Entry & entry = entries[key];
+			entry.fetched = Clock::now();
+			entry.value = value;
+			entry.table.reset(table != NULL ? new std::string(*table) : NULL);
+		}
+
+		return value;
+	}
+
+	// Drops the entries older than `ttl`. The caller must hold the lock.
+	void expire() {
+		const auto now = Clock::now();
+
+		for (auto i = entries.begin(); i != entries.end();) {
+			i = now - i->second.fetched >= ttl ? entries.erase(i) : std::next(i);
+		}
+	}
+
+	// Drops the lookups that may have found `table` or its columns, keys or privileges, or every
+	// entry if `table` is `NULL`.
+	void invalidate(const char * table) {
+		std::lock_guard<std::mutex> guard(mutex);
+
+		if (table == NULL) {
+			entries.clear();
+			return;
+		}
+
+		for (auto i = entries.begin(); i != entries.end();) {
+			const std::string * pattern = i->second.table.get();
+			// An empty or wildcard table argument may have matched `table` as well.
+			const bool matches = pattern != NULL &&
+								 (*pattern == table || pattern->empty() ||
+								  pattern->find_first_of("%_") != std::string::npos);
+
+			i = matches ? entries.erase(i) : std::next(i);
+		}
+	}
+
+	void setTTL(long milliseconds) {
+		std::lock_guard<std::mutex> guard(mutex);
+		ttl = std::chrono::milliseconds(milliseconds > 0 ? milliseconds : 0);
+		expire();
+	}
+
+	CMetadataCacheStatistics statistics() {
+		std::lock_guard<std::mutex> guard(mutex);
+
+		return CMetadataCacheStatistics { .ttl = static_cast<long>(ttl.count()),
+										  .size = static_cast<long>(entries.size()),
+										  .hits = hits,
+										  .misses = misses };
+	}
+};
+
+#endif /* Catalog_h */
@@ -4,79 +4,139 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
-#include "../nanodbc.h"
+#include "Catalog.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
-#include <cstring>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogColumn>> readColumns(
+		nanodbc::catalog::columns found) {
+		CatalogRowsBuilder<CCatalogColumn> rows;
+
+		while (found.next()) {
+			CCatalogColumn & column = rows.append();
+			rows.set(&CCatalogColumn::tableCatalog, found.table_catalog());
+			rows.set(&CCatalogColumn::tableSchema, found.table_schema());
+			rows.set(&CCatalogColumn::tableName, found.table_name());
+			rows.set(&CCatalogColumn::name, found.column_name());
+			rows.set(&CCatalogColumn::typeName, found.type_name());
+			rows.set(&CCatalogColumn::remarks, found.remarks());
+			rows.set(&CCatalogColumn::defaultValue, found.column_default());
+			rows.set(&CCatalogColumn::isNullable, found.is_nullable());
+			column.columnSize = found.column_size();
+			column.bufferLength = found.buffer_length();
+			column.charOctetLength = found.char_octet_length();
+			column.ordinalPosition = found.ordinal_position();
+			column.dataType = found.data_type();
+			column.decimalDigits = found.decimal_digits();
+			column.numericPrecisionRadix = found.numeric_precision_radix();
+			column.nullable = found.nullable();
+			column.sqlDataType = found.sql_data_type();
+			column.sqlDateTimeSubType = found.sql_datetime_subtype();
+		}
+
+		return rows.finish();
+	}
+}
+
+CColumns * _Nullable catalogFindColumns(
+	CCatalog * _Nonnull catalogPointer, const char * _Nonnull column, const char * _Nonnull table,
+	const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error) {
+	try {
+		const std::string tableName(table);
+
+		auto columns = catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogColumn>>(
+			lookupKey("columns", { column, table, schema, catalog }), &tableName, [=] {
+				return readColumns(
+					catalogPointer->catalog.find_columns(column, table, schema, catalog));
+			});
+
+		return new CColumns(columns);
+	} catch (...) {
+		setError(error);
+
+		return NULL;
+	}
+}
 
 long catalogColumnBufferLength(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->buffer_length();
+	return columns->current().bufferLength;
 }
 
 long catalogColumnCharOctetLength(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->char_octet_length();
+	return columns->current().charOctetLength;
 }
 
 const char * _Nonnull catalogColumnDefault(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->column_default().c_str());
+	return columns->current().defaultValue;
 }
 
 const char * _Nonnull catalogColumnName(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->column_name().c_str());
+	return columns->current().name;
 }
 
 long catalogColumnSize(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->column_size();
+	return columns->current().columnSize;
 }
 
 short catalogColumnDataType(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->data_type();
+	return columns->current().dataType;
 }
 
 short catalogColumnDecimalDigits(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->decimal_digits();
+	return columns->current().decimalDigits;
 }
 
 const char * _Nonnull catalogIsNullable(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->is_nullable().c_str());
+	return columns->current().isNullable;
 }
 
 bool catalogColumnNext(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->next();
+	const long count = static_cast<long>(columns->rows->rows.size());
+
+	if (columns->position < count) { columns->position++; }
+	return columns->position < count;
 }
 
 short catalogColumnNumericPrecisionRadix(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->numeric_precision_radix();
+	return columns->current().numericPrecisionRadix;
 }
 
 long catalogColumnOrdinalPosition(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->ordinal_position();
+	return columns->current().ordinalPosition;
 }
 
 const char * _Nonnull catalogColumnRemarks(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->remarks().c_str());
+	return columns->current().remarks;
 }
 
 short catalogColumnSQLDataType(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->sql_data_type();
+	return columns->current().sqlDataType;
 }
 
 short catalogColumnSQLDateTimeSubType(CColumns * _Nonnull columns) {
-	return reinterpret_cast<nanodbc::catalog::columns *>(columns)->sql_datetime_subtype();
+	return columns->current().sqlDateTimeSubType;
 }
 
 const char * _Nonnull catalogColumnTableCatalog(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->table_catalog().c_str());
+	return columns->current().tableCatalog;
 }
 
 const char * _Nonnull catalogColumnTableName(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->table_name().c_str());
+	return columns->current().tableName;
 }
 
 const char * _Nonnull catalogColumnTableSchema(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->table_schema().c_str());
+	return columns->current().tableSchema;
 }
 
 const char * _Nonnull catalogColumnTypeName(CColumns * _Nonnull columns) {
-	return strdup(reinterpret_cast<nanodbc::catalog::columns *>(columns)->type_name().c_str());
+	return columns->current().typeName;
 }
+
+const CCatalogColumn * _Nullable catalogColumnsArray(
+	CColumns * _Nonnull columns, unsigned long * _Nonnull count) {
+	return columns->array(count);
+}
+
+void catalogColumnsDestroy(CColumns * _Nonnull columns) { delete columns; }
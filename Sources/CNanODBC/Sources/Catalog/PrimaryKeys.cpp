@@ -0,0 +1,55 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogPrimaryKey>> readPrimaryKeys(
+		nanodbc::catalog::primary_keys found) {
+		CatalogRowsBuilder<CCatalogPrimaryKey> rows;
+
+		while (found.next()) {
+			CCatalogPrimaryKey & key = rows.append();
+			rows.set(&CCatalogPrimaryKey::tableCatalog, found.table_catalog());
+			rows.set(&CCatalogPrimaryKey::tableSchema, found.table_schema());
+			rows.set(&CCatalogPrimaryKey::tableName, found.table_name());
+			rows.set(&CCatalogPrimaryKey::columnName, found.column_name());
+			rows.set(&CCatalogPrimaryKey::primaryKeyName, found.primary_key_name());
+			key.columnNumber = found.column_number();
+		}
+
+		return rows.finish();
+	}
+}
+
+extern "C" {
+	CPrimaryKeys * _Nullable catalogFindPrimaryKeys(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error) {
+		try {
+			const std::string tableName(table);
+
+			auto keys = catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogPrimaryKey>>(
+				lookupKey("primaryKeys", { table, schema, catalog }), &tableName, [=] {
+					return readPrimaryKeys(
+						catalogPointer->catalog.find_primary_keys(table, schema, catalog));
+				});
+
+			return new CPrimaryKeys(keys);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	const CCatalogPrimaryKey * _Nullable catalogPrimaryKeysArray(
+		CPrimaryKeys * _Nonnull keys, unsigned long * _Nonnull count) {
+		return keys->array(count);
+	}
+
+	void catalogPrimaryKeysDestroy(CPrimaryKeys * _Nonnull keys) { delete keys; }
+}
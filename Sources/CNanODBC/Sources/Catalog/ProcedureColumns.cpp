@@ -0,0 +1,69 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogProcedureColumn>> readProcedureColumns(
+		nanodbc::catalog::procedure_columns found) {
+		CatalogRowsBuilder<CCatalogProcedureColumn> rows;
+
+		while (found.next()) {
+			CCatalogProcedureColumn & column = rows.append();
+			rows.set(&CCatalogProcedureColumn::procedureCatalog, found.procedure_catalog());
+			rows.set(&CCatalogProcedureColumn::procedureSchema, found.procedure_schema());
+			rows.set(&CCatalogProcedureColumn::procedureName, found.procedure_name());
+			rows.set(&CCatalogProcedureColumn::columnName, found.column_name());
+			rows.set(&CCatalogProcedureColumn::typeName, found.type_name());
+			rows.set(&CCatalogProcedureColumn::remarks, found.remarks());
+			rows.set(&CCatalogProcedureColumn::defaultValue, found.column_default());
+			rows.set(&CCatalogProcedureColumn::isNullable, found.is_nullable());
+			column.columnSize = found.column_size();
+			column.bufferLength = found.buffer_length();
+			column.charOctetLength = found.char_octet_length();
+			column.ordinalPosition = found.ordinal_position();
+			column.columnType = found.column_type();
+			column.dataType = found.data_type();
+			column.decimalDigits = found.decimal_digits();
+			column.numericPrecisionRadix = found.numeric_precision_radix();
+			column.nullable = found.nullable();
+			column.sqlDataType = found.sql_data_type();
+			column.sqlDateTimeSubType = found.sql_datetime_subtype();
+		}
+
+		return rows.finish();
+	}
+}
+
+extern "C" {
+	CProcedureColumns * _Nullable catalogFindProcedureColumns(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull column,
+		const char * _Nonnull procedure, const char * _Nonnull schema,
+		const char * _Nonnull catalog, CError * _Nonnull error) {
+		try {
+			auto columns =
+				catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogProcedureColumn>>(
+					lookupKey("procedureColumns", { column, procedure, schema, catalog }), NULL,
+					[=] {
+						return readProcedureColumns(catalogPointer->catalog.find_procedure_columns(
+							column, procedure, schema, catalog));
+					});
+
+			return new CProcedureColumns(columns);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	const CCatalogProcedureColumn * _Nullable catalogProcedureColumnsArray(
+		CProcedureColumns * _Nonnull columns, unsigned long * _Nonnull count) {
+		return columns->array(count);
+	}
+
+	void catalogProcedureColumnsDestroy(CProcedureColumns * _Nonnull columns) { delete columns; }
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogProcedure>> readProcedures(
+		nanodbc::catalog::procedures found) {
+		CatalogRowsBuilder<CCatalogProcedure> rows;
+
+		while (found.next()) {
+			CCatalogProcedure & procedure = rows.append();
+			rows.set(&CCatalogProcedure::procedureCatalog, found.procedure_catalog());
+			rows.set(&CCatalogProcedure::procedureSchema, found.procedure_schema());
+			rows.set(&CCatalogProcedure::procedureName, found.procedure_name());
+			rows.set(&CCatalogProcedure::remarks, found.procedure_remarks());
+			procedure.procedureType = found.procedure_type();
+		}
+
+		return rows.finish();
+	}
+}
+
+extern "C" {
+	CProcedures * _Nullable catalogFindProcedures(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull procedure,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error) {
+		try {
+			auto procedures =
+				catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogProcedure>>(
+					lookupKey("procedures", { procedure, schema, catalog }), NULL, [=] {
+						return readProcedures(
+							catalogPointer->catalog.find_procedures(procedure, schema, catalog));
+					});
+
+			return new CProcedures(procedures);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	const CCatalogProcedure * _Nullable catalogProceduresArray(
+		CProcedures * _Nonnull procedures, unsigned long * _Nonnull count) {
+		return procedures->array(count);
+	}
+
+	void catalogProceduresDestroy(CProcedures * _Nonnull procedures) { delete procedures; }
+}
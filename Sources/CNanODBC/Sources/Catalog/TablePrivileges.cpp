@@ -0,0 +1,59 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogTablePrivilege>> readTablePrivileges(
+		nanodbc::catalog::table_privileges found) {
+		CatalogRowsBuilder<CCatalogTablePrivilege> rows;
+
+		while (found.next()) {
+			rows.append();
+			rows.set(&CCatalogTablePrivilege::tableCatalog, found.table_catalog());
+			rows.set(&CCatalogTablePrivilege::tableSchema, found.table_schema());
+			rows.set(&CCatalogTablePrivilege::tableName, found.table_name());
+			rows.set(&CCatalogTablePrivilege::grantor, found.grantor());
+			rows.set(&CCatalogTablePrivilege::grantee, found.grantee());
+			rows.set(&CCatalogTablePrivilege::privilege, found.privilege());
+			rows.set(&CCatalogTablePrivilege::isGrantable, found.is_grantable());
+		}
+
+		return rows.finish();
+	}
+}
+
+extern "C" {
+	CTablePrivileges * _Nullable catalogFindTablePrivileges(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error) {
+		try {
+			const std::string tableName(table);
+
+			auto privileges =
+				catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogTablePrivilege>>(
+					lookupKey("tablePrivileges", { table, schema, catalog }), &tableName, [=] {
+						return readTablePrivileges(
+							catalogPointer->catalog.find_table_privileges(catalog, table, schema));
+					});
+
+			return new CTablePrivileges(privileges);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	const CCatalogTablePrivilege * _Nullable catalogTablePrivilegesArray(
+		CTablePrivileges * _Nonnull privileges, unsigned long * _Nonnull count) {
+		return privileges->array(count);
+	}
+
+	void catalogTablePrivilegesDestroy(CTablePrivileges * _Nonnull privileges) {
+		delete privileges;
+	}
+}
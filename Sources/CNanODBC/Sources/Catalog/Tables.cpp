@@ -0,0 +1,53 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+
+namespace {
+	std::shared_ptr<const CatalogRows<CCatalogTable>> readTables(nanodbc::catalog::tables found) {
+		CatalogRowsBuilder<CCatalogTable> rows;
+
+		while (found.next()) {
+			rows.append();
+			rows.set(&CCatalogTable::tableCatalog, found.table_catalog());
+			rows.set(&CCatalogTable::tableSchema, found.table_schema());
+			rows.set(&CCatalogTable::tableName, found.table_name());
+			rows.set(&CCatalogTable::tableType, found.table_type());
+			rows.set(&CCatalogTable::remarks, found.table_remarks());
+		}
+
+		return rows.finish();
+	}
+}
+
+extern "C" {
+	CTables * _Nullable catalogFindTables(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table, const char * _Nonnull type,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error) {
+		try {
+			const std::string tableName(table);
+
+			auto tables = catalogPointer->owner.metadata->lookup<CatalogRows<CCatalogTable>>(
+				lookupKey("tables", { table, type, schema, catalog }), &tableName, [=] {
+					return readTables(
+						catalogPointer->catalog.find_tables(table, type, schema, catalog));
+				});
+
+			return new CTables(tables);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	const CCatalogTable * _Nullable catalogTablesArray(
+		CTables * _Nonnull tables, unsigned long * _Nonnull count) {
+		return tables->array(count);
+	}
+
+	void catalogTablesDestroy(CTables * _Nonnull tables) { delete tables; }
+}
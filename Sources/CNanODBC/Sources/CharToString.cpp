@@ -5,7 +5,29 @@
 //  The full text of the license can be found in the file named LICENSE.
 
 #include "../nanodbc.h"
+#include "../nanodbc_utf.h"
 #include <CNanODBC/CxxFuncs.h>
+#include <codecvt>
+#include <cstring>
+#include <locale>
+#include <stdexcept>
 #include <string>
 
-std::string charToString(const char * string) { return NANODBC_TEXT(string); }
+nanodbc::string charToString(const char * string) {
+#if defined(NANODBC_ENABLE_UNICODE) && defined(NANODBC_USE_IODBC_WIDE_STRINGS)
+	static thread_local std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter;
+	return converter.from_bytes(string);
+#elif defined(NANODBC_ENABLE_UNICODE)
+	const size_t length = std::strlen(string);
+	nanodbc::string result(length, 0);
+	const size_t written =
+		nanodbc::utf::utf8_to_utf16(string, length, reinterpret_cast<char16_t *>(&result[0]));
+
+	if (written == nanodbc::utf::npos) { throw std::range_error("charToString: invalid UTF-8"); }
+
+	result.resize(written);
+	return result;
+#else
+	return string;
+#endif
+}
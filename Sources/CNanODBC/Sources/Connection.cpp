@@ -4,7 +4,7 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
-#include "../nanodbc.h"
+#include "Handles.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
 #include <string.h>
@@ -15,10 +15,10 @@ extern "C" {
 		try {
 			error->isValid = false;
 			return reinterpret_cast<CConnection *>(
-				new nanodbc::connection(charToString(connStr), timeout));
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+				new ConnectionHandle(nanodbc::connection(charToString(connStr), timeout)));
+		} catch (...) {
+			setError(error);
+
 			return NULL;
 		}
 	}
@@ -27,44 +27,57 @@ extern "C" {
 		const char * _Nonnull dsn, const char * _Nonnull username, const char * _Nonnull password,
 		long timeout, CError * _Nonnull error) {
 		try {
-			return reinterpret_cast<CConnection *>(new nanodbc::connection(
-				charToString(dsn), charToString(username), charToString(password), timeout));
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+			return reinterpret_cast<CConnection *>(new ConnectionHandle(nanodbc::connection(
+				charToString(dsn), charToString(username), charToString(password), timeout)));
+		} catch (...) {
+			setError(error);
+
 			return NULL;
 		}
 	}
 
 	bool connectionConnected(CConnection * _Nonnull conn) {
-		return reinterpret_cast<nanodbc::connection *>(conn)->connected();
+		return connection(conn).connected();
 	}
 
 	const char * _Nonnull connectionDBMSName(CConnection * _Nonnull conn) {
-		return strdup(reinterpret_cast<nanodbc::connection *>(conn)->dbms_name().c_str());
+		return strdup(connection(conn).dbms_name().c_str());
 	}
 
 	const char * _Nonnull connectionDBMSVersion(CConnection * _Nonnull conn) {
-		return strdup(reinterpret_cast<nanodbc::connection *>(conn)->dbms_version().c_str());
+		return strdup(connection(conn).dbms_version().c_str());
 	}
 
 	const char * _Nonnull connectionDatabaseName(CConnection * _Nonnull conn) {
-		return strdup(reinterpret_cast<nanodbc::connection *>(conn)->database_name().c_str());
+		return strdup(connection(conn).database_name().c_str());
 	}
 
 	CError * _Nullable connectionDisconnect(CConnection * _Nonnull conn) {
 		try {
-			reinterpret_cast<nanodbc::connection *>(conn)->disconnect();
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-		}
+			connection(conn).disconnect();
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
 
 	void destroyConnection(CConnection * _Nonnull conn) {
-		// delete reinterpret_cast<nanodbc::connection *>(conn);
+		delete reinterpret_cast<ConnectionHandle *>(conn);
+	}
+
+	// MARK: - Statement Cache
+
+	void connectionSetStatementCacheCapacity(CConnection * _Nonnull conn, long capacity) {
+		auto & cache = handle(conn).statements;
+		cache.capacity = capacity > 0 ? capacity : 0;
+		cache.trim();
+	}
+
+	CStatementCacheStatistics connectionStatementCacheStatistics(CConnection * _Nonnull conn) {
+		const auto & cache = handle(conn).statements;
+
+		return CStatementCacheStatistics { .capacity = static_cast<long>(cache.capacity),
+										   .size = static_cast<long>(cache.entries.size()),
+										   .hits = cache.hits,
+										   .misses = cache.misses };
 	}
 }
@@ -7,6 +7,9 @@
 #include "../nanodbc.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
+#include <cstring>
+#include <sql.h>
+#include <sqlext.h>
 
 nanodbc::date cDateToDate(CDate date) {
 	return nanodbc::date { .year = date.year, .month = date.month, .day = date.day };
@@ -25,3 +28,28 @@ nanodbc::timestamp cTimeStampToTimestamp(CTimeStamp ts) {
 								.sec = ts.second,
 								.fract = ts.fractionalSec };
 }
+
+// Howard Hinnant's `days_from_civil`, valid for every date of the proleptic Gregorian calendar.
+int32_t daysSinceEpoch(int16_t year, int16_t month, int16_t day) {
+	const int32_t y = year - (month <= 2);
+	const int32_t era = (y >= 0 ? y : y - 399) / 400;
+	const int32_t yearOfEra = y - era * 400;
+	const int32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	const int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	return era * 146097 + dayOfEra - 719468;
+}
+
+int64_t microsecondsSinceEpoch(const nanodbc::timestamp & ts) {
+	const int64_t seconds = int64_t(daysSinceEpoch(ts.year, ts.month, ts.day)) * 86400 +
+							ts.hour * 3600 + ts.min * 60 + ts.sec;
+	return seconds * 1000000 + ts.fract / 1000;
+}
+
+// The driver null-terminates bound character data, so a truncated or unknown length is bounded by
+// the buffer minus the terminator.
+size_t boundStringLength(const char * value, unsigned long length, nanodbc::null_type indicator) {
+	if (indicator == SQL_NULL_DATA) { return 0; }
+
+	return indicator == SQL_NO_TOTAL || indicator >= (long) length ? strnlen(value, length)
+																	: static_cast<size_t>(indicator);
+}
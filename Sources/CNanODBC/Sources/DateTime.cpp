@@ -0,0 +1,118 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <algorithm>
+#include <cstring>
+#include <sql.h>
+#include <sqlext.h>
+
+namespace {
+	// Reads the value of `column` in the current row of `res` into `out`, reporting any failure
+	// through `error`. `read` must be a call to `nanodbc::result::get`.
+	template <typename T, typename Read> bool getInto(T & out, CError * error, Read read) {
+		try {
+			out = read();
+			return true;
+		} catch (...) { setError(error); }
+
+		return false;
+	}
+
+	template <typename T>
+	T get(CResult * rawRes, const short * colNum, const char * colName) {
+		nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+		return colNum != NULL ? res.get<T>(*colNum) : res.get<T>(charToString(colName));
+	}
+}
+
+extern "C" {
+	bool resultGetDateInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CDate * _Nonnull out, CError * _Nonnull error) {
+		return getInto(*out, error, [&] {
+			const auto date = get<nanodbc::date>(rawRes, colNum, colName);
+			return CDate { .month = date.month, .day = date.day, .year = date.year };
+		});
+	}
+
+	bool resultGetTimeInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CTime * _Nonnull out, CError * _Nonnull error) {
+		return getInto(*out, error, [&] {
+			const auto time = get<nanodbc::time>(rawRes, colNum, colName);
+			return CTime { .hour = time.hour, .minute = time.min, .second = time.sec };
+		});
+	}
+
+	bool resultGetTimeStampInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CTimeStamp * _Nonnull out, CError * _Nonnull error) {
+		return getInto(*out, error, [&] {
+			const auto ts = get<nanodbc::timestamp>(rawRes, colNum, colName);
+			return CTimeStamp { .date = CDate { .month = ts.month, .day = ts.day, .year = ts.year },
+								.hour = ts.hour,
+								.minute = ts.min,
+								.second = ts.sec,
+								.fractionalSec = ts.fract };
+		});
+	}
+
+	long resultGetEpochMicroseconds(
+		CResult * _Nonnull rawRes, short column, int64_t * _Nonnull out, uint8_t * _Nonnull validity,
+		long capacity, CError * _Nonnull error) {
+		try {
+			nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+
+			if (capacity <= 0 || res.at_end()) { return 0; }
+
+			std::memset(validity, 0, static_cast<size_t>((capacity + 7) / 8));
+
+			const char * data = res.column_bound_data(column);
+
+			// Unbound or converted columns can only be read one row at a time.
+			if (data == nullptr || res.column_c_datatype(column) != SQL_C_TIMESTAMP) {
+				if (res.is_null(column)) {
+					out[0] = 0;
+				} else {
+					out[0] = microsecondsSinceEpoch(res.get<nanodbc::timestamp>(column));
+					validity[0] = 1;
+				}
+
+				return 1;
+			}
+
+			const unsigned long length = res.column_bound_length(column);
+			const nanodbc::null_type * indicators = res.column_bound_indicators(column);
+			const long position = res.rowset_position();
+			const long count = std::min(std::max(res.rows(), position + 1) - position, capacity);
+
+			for (long i = 0; i < count; i++) {
+				const long row = position + i;
+
+				if (indicators[row] == SQL_NULL_DATA) {
+					out[i] = 0;
+					continue;
+				}
+
+				nanodbc::timestamp ts;
+				std::memcpy(&ts, data + row * length, sizeof(ts));
+
+				out[i] = microsecondsSinceEpoch(ts);
+				validity[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+			}
+
+			// Stay inside the rowset, so that the next `resultNext` fetches the following one.
+			if (count > 1) { res.skip(count - 1); }
+
+			return count;
+		} catch (...) { setError(error); }
+
+		return -1;
+	}
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <cmath>
+#include <cstring>
+#include <sql.h>
+#include <sqlext.h>
+
+namespace {
+	typedef unsigned __int128 Magnitude;
+
+	const int maxDigits = 38;
+	const int maxScale = 38;
+
+	Magnitude magnitude(const CDecimal & decimal) {
+		return (static_cast<Magnitude>(decimal.high) << 64) | decimal.low;
+	}
+
+	CDecimal makeDecimal(Magnitude magnitude, int scale, bool negative) {
+		return CDecimal { .low = static_cast<uint64_t>(magnitude),
+						  .high = static_cast<uint64_t>(magnitude >> 64),
+						  .scale = static_cast<int16_t>(scale),
+						  .negative = negative && magnitude != 0 };
+	}
+
+	bool isDigit(char c) { return c >= '0' && c <= '9'; }
+}
+
+// Hand-written rather than `strtod`/`std::stod`, which depend on the C locale's decimal point
+// and lose every digit past the 17th.
+bool parseDecimal(const char * text, size_t length, CDecimal & out) {
+	const char * p = text;
+	const char * end = text + length;
+
+	while (p < end && *p == ' ') { p++; }
+	while (end > p && (end[-1] == ' ' || end[-1] == '\0')) { end--; }
+
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) { negative = *p++ == '-'; }
+
+	Magnitude mantissa = 0;
+	int digits = 0;
+	int scale = 0;
+	bool seenDigit = false;
+	bool seenPoint = false;
+
+	for (; p < end; p++) {
+		if (isDigit(*p)) {
+			seenDigit = true;
+			// Leading zeros do not count towards the precision.
+			if ((digits > 0 || *p != '0') && ++digits > maxDigits) { return false; }
+			mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+			if (seenPoint) { scale++; }
+		} else if (*p == '.' && !seenPoint) {
+			seenPoint = true;
+		} else {
+			break;
+		}
+	}
+
+	if (!seenDigit) { return false; }
+
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		p++;
+		bool negativeExponent = false;
+		if (p < end && (*p == '-' || *p == '+')) { negativeExponent = *p++ == '-'; }
+		if (p == end) { return false; }
+
+		int exponent = 0;
+		for (; p < end && isDigit(*p); p++) {
+			exponent = exponent * 10 + (*p - '0');
+			if (exponent > 2 * maxDigits) { return false; }
+		}
+
+		scale += negativeExponent ? exponent : -exponent;
+	}
+
+	if (p != end) { return false; }
+
+	for (; scale < 0; scale++) {
+		if (++digits > maxDigits) { return false; }
+		mantissa *= 10;
+	}
+
+	for (; scale > maxScale; scale--) {
+		if (mantissa % 10 != 0) { return false; }
+		mantissa /= 10;
+	}
+
+	out = makeDecimal(mantissa, scale, negative);
+	return true;
+}
+
+bool boundDecimal(nanodbc::result & res, short column, CDecimal & out) {
+	const char * data = res.column_bound_data(column);
+	if (data == nullptr || res.column_c_datatype(column) != SQL_C_CHAR) { return false; }
+
+	const unsigned long length = res.column_bound_length(column);
+	const long position = res.rowset_position();
+	const nanodbc::null_type indicator = res.column_bound_indicators(column)[position];
+
+	if (indicator == SQL_NULL_DATA) { throw nanodbc::null_access_error(); }
+
+	const char * text = data + position * length;
+	return parseDecimal(text, boundStringLength(text, length, indicator), out);
+}
+
+extern "C" {
+	CDecimal resultGetDecimal(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CError * _Nonnull error) {
+		try {
+			nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+			const short column = colNum != NULL ? *colNum : res.column(charToString(colName));
+			CDecimal decimal;
+
+			if (boundDecimal(res, column, decimal)) { return decimal; }
+
+			const std::string text = res.get<std::string>(column);
+			if (parseDecimal(text.data(), text.size(), decimal)) { return decimal; }
+
+			throw nanodbc::type_incompatible_error();
+		} catch (...) { setError(error); }
+
+		return makeDecimal(0, 0, false);
+	}
+
+	bool decimalParse(const char * _Nonnull text, unsigned long length, CDecimal * _Nonnull out) {
+		return parseDecimal(text, length, *out);
+	}
+
+	unsigned long decimalFormat(CDecimal decimal, char * _Nonnull buffer) {
+		// Least significant digit first, padded so there is a digit before the decimal point.
+		char digits[maxDigits + 2];
+		int count = 0;
+		Magnitude m = magnitude(decimal);
+
+		do {
+			digits[count++] = static_cast<char>('0' + static_cast<int>(m % 10));
+			m /= 10;
+		} while (m != 0);
+
+		while (count <= decimal.scale) { digits[count++] = '0'; }
+
+		char * p = buffer;
+		if (decimal.negative) { *p++ = '-'; }
+
+		for (int i = count - 1; i >= 0; i--) {
+			*p++ = digits[i];
+			if (i == decimal.scale && i > 0) { *p++ = '.'; }
+		}
+
+		*p = '\0';
+		return static_cast<unsigned long>(p - buffer);
+	}
+
+	double decimalToDouble(CDecimal decimal) {
+		static const double powers[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+										 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+										 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		const Magnitude m = magnitude(decimal);
+		double value;
+
+		if (m <= (Magnitude(1) << 53) && decimal.scale <= 22) {
+			// Both operands are exact, so the single division is correctly rounded.
+			value = static_cast<double>(static_cast<uint64_t>(m)) / powers[decimal.scale];
+		} else {
+			value = static_cast<double>(
+				static_cast<long double>(m) / std::pow(10.0L, static_cast<long double>(decimal.scale)));
+		}
+
+		return decimal.negative ? -value : value;
+	}
+
+	CDecimal decimalNormalized(CDecimal decimal) {
+		Magnitude m = magnitude(decimal);
+		int scale = decimal.scale;
+
+		for (; scale > 0 && m % 10 == 0; scale--) { m /= 10; }
+
+		return makeDecimal(m, scale, decimal.negative);
+	}
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <cstring>
+#include <string>
+
+namespace {
+	struct ErrorRecord {
+		CError error = CError { .isValid = false, .message = NULL, .reason = general };
+		// Owns the message of `error`. Its capacity is kept between errors, so reporting an error
+		// only allocates if the message is longer than every previous one.
+		std::string message;
+	};
+
+	thread_local ErrorRecord record;
+}
+
+void setError(CError * error, const char * message, ErrorReason reason) noexcept {
+	if (error == &record.error) {
+		try {
+			record.message.assign(message);
+			error->message = &record.message[0];
+		} catch (std::exception &) { error->message = NULL; }
+	} else {
+		// Errors that do not live in the calling thread's record own their message.
+		error->message = strdup(message);
+	}
+
+	error->isValid = true;
+	error->reason = reason;
+}
+
+void setError(CError * error) noexcept {
+	try {
+		throw;
+	} catch (nanodbc::database_error & e) {
+		setError(error, e.what(), databaseError);
+	} catch (nanodbc::index_range_error & e) {
+		setError(error, e.what(), indexOutOfRange);
+	} catch (nanodbc::type_incompatible_error & e) {
+		setError(error, e.what(), invalidType);
+	} catch (nanodbc::null_access_error & e) {
+		setError(error, e.what(), nullAccessError);
+	} catch (nanodbc::programming_error & e) {
+		setError(error, e.what(), programmingError);
+	} catch (std::exception & e) {
+		setError(error, e.what(), general);
+	} catch (...) { setError(error, "Unknown error", general); }
+}
+
+CError * threadErrorFromException() noexcept {
+	CError * error = &record.error;
+	setError(error);
+	return error;
+}
+
+extern "C" {
+	CError * _Nonnull threadError(void) {
+		record.error.isValid = false;
+		return &record.error;
+	}
+}
@@ -4,7 +4,7 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
-#include "../nanodbc.h"
+#include "Handles.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
 #include <cstring>
@@ -15,30 +15,22 @@ extern "C" {
 		long timeout, CError * _Nonnull error) {
 		try {
 			nanodbc::just_execute(
-				*reinterpret_cast<nanodbc::connection *>(rawConn), query, batchOperations, timeout);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
-		}
+				connection(rawConn), charToString(query), batchOperations, timeout);
+		} catch (...) { setError(error); }
 	}
 
 	CResult * _Nullable cExecute(
 		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
-		long timeout, CError * _Nonnull error) {
+		long rowsetSize, long timeout, CError * _Nonnull error) {
 		try {
-			return reinterpret_cast<CResult *>(new nanodbc::result(nanodbc::execute(
-				*reinterpret_cast<nanodbc::connection *>(rawConn), query, batchOperations,
-				timeout)));
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+			nanodbc::statement stmt;
+			return reinterpret_cast<CResult *>(new nanodbc::result(stmt.execute_direct(
+				connection(rawConn), charToString(query), batchOperations, timeout,
+				rowsetSize)));
+		} catch (...) {
+			setError(error);
 
 			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
-			return NULL;
 		}
 	}
 }
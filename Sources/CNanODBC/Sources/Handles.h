@@ -0,0 +1,112 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#ifndef Handles_h
+#define Handles_h
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+struct ConnectionHandle;
+struct MetadataCache;
+
+// A cache of catalog lookups for a connection that does not share one, see `Catalog/Catalog.h`.
+std::shared_ptr<MetadataCache> makeMetadataCache();
+
+// A statement together with stable storage for its single-value parameters.
+//
+// nanodbc binds parameters by address, so every value is copied into a slot that lives as long
+// as the statement. Binding a parameter again with a value of the same type only overwrites its
+// slot; `SQLDescribeParam` and `SQLBindParameter` run again only when the type or nullness of
+// the parameter changes, or when a string no longer fits into its slot.
+struct StatementHandle {
+	struct Parameter {
+		// The type of the value in `storage`, or `NULL` if the parameter is not bound to it.
+		const std::type_info * type = NULL;
+		size_t capacity = 0;
+		std::unique_ptr<char[]> storage;
+	};
+
+	StatementHandle(ConnectionHandle & owner, const std::string & query, long timeout);
+
+	ConnectionHandle & owner;
+	const std::string query;
+	// The timeout the statement was prepared with; only a request for the same one reuses it.
+	const long timeout;
+	nanodbc::statement stmt;
+	std::map<short, Parameter> parameters;
+};
+
+// A connection together with its cache of prepared statements and catalog lookups.
+//
+// Statements that are destroyed while still prepared are kept, most recently used first, and
+// handed out again by `stmtCreate` for the same query and timeout instead of preparing it anew. Catalog
+// lookups are cached in `metadata`, which the connections of a pool share.
+struct ConnectionHandle {
+	struct StatementCache {
+		size_t capacity = 16;
+		long hits = 0;
+		long misses = 0;
+		std::list<StatementHandle *> entries;
+		std::unordered_multimap<std::string, std::list<StatementHandle *>::iterator> index;
+
+		// Deletes the least recently used statements until at most `capacity` are left.
+		void trim() {
+			while (entries.size() > capacity) {
+				StatementHandle * stmt = entries.back();
+				auto range = index.equal_range(stmt->query);
+
+				for (auto i = range.first; i != range.second; ++i) {
+					if (*i->second == stmt) {
+						index.erase(i);
+						break;
+					}
+				}
+
+				entries.pop_back();
+				delete stmt;
+			}
+		}
+	};
+
+	explicit ConnectionHandle(
+		const nanodbc::connection & conn,
+		std::shared_ptr<MetadataCache> metadata = makeMetadataCache())
+		: conn(conn), metadata(metadata) {}
+	~ConnectionHandle() {
+		for (auto stmt : statements.entries) { delete stmt; }
+	}
+
+	nanodbc::connection conn;
+	StatementCache statements;
+	const std::shared_ptr<MetadataCache> metadata;
+};
+
+inline StatementHandle::StatementHandle(
+	ConnectionHandle & owner, const std::string & query, long timeout)
+	: owner(owner), query(query), timeout(timeout),
+	  stmt(owner.conn, charToString(query.c_str()), timeout) {}
+
+inline ConnectionHandle & handle(CConnection * rawConn) {
+	return *reinterpret_cast<ConnectionHandle *>(rawConn);
+}
+
+inline nanodbc::connection & connection(CConnection * rawConn) { return handle(rawConn).conn; }
+
+inline StatementHandle & handle(CStatement * rawStmt) {
+	return *reinterpret_cast<StatementHandle *>(rawStmt);
+}
+
+inline nanodbc::statement & statement(CStatement * rawStmt) { return handle(rawStmt).stmt; }
+
+#endif /* Handles_h */
@@ -0,0 +1,193 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Handles.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Every partition is executed and read on a thread of its own. The batches they fill are handed
+// to the consumer in the order they become ready; batches the consumer is done with are refilled
+// by whichever partition needs one next.
+struct CPartitionedQuery {
+	long rowsetSize;
+	long maxRows;
+	long timeout;
+
+	std::mutex mutex;
+	std::condition_variable changed;
+
+	std::deque<CBatch *> ready;
+	std::vector<CBatch *> spare;
+	// The batch handed out by the last `partitionedNext`.
+	CBatch * current = NULL;
+	// The amount of ready batches after which partitions wait for the consumer.
+	size_t capacity;
+
+	size_t running = 0;
+	bool stopping = false;
+
+	bool failed = false;
+	std::string message;
+	ErrorReason reason = general;
+
+	std::vector<std::thread> workers;
+
+	void run(CStatement * rawStmt) {
+		CError * error = threadError();
+		CBatch * batch = NULL;
+
+		try {
+			nanodbc::result res = statement(rawStmt).execute(1, timeout, rowsetSize);
+			CResult * rawRes = reinterpret_cast<CResult *>(&res);
+
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					changed.wait(lock, [this] { return ready.size() < capacity || stopping; });
+
+					if (stopping) { break; }
+
+					if (batch == NULL && !spare.empty()) {
+						batch = spare.back();
+						spare.pop_back();
+					}
+				}
+
+				CBatch * filled = resultFetchBatch(rawRes, maxRows, batch, error);
+
+				if (filled == NULL) { break; }
+
+				batch = filled;
+
+				// A short batch means the result has run out of rows.
+				const bool last = batch->rowCount < maxRows;
+
+				if (batch->rowCount > 0) {
+					std::lock_guard<std::mutex> guard(mutex);
+					ready.push_back(batch);
+					batch = NULL;
+					changed.notify_all();
+				}
+
+				if (last) { break; }
+			}
+		} catch (...) { setError(error); }
+
+		std::lock_guard<std::mutex> guard(mutex);
+
+		if (batch != NULL) { spare.push_back(batch); }
+
+		// Only the first error is reported; the other partitions stop at their next batch.
+		if (error->isValid && !failed) {
+			failed = true;
+			stopping = true;
+			reason = error->reason;
+			message = error->message != NULL ? error->message : "Unknown error";
+		}
+
+		running--;
+		changed.notify_all();
+	}
+
+	// Stops the partitions and waits for them to finish.
+	void stop() {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			stopping = true;
+			changed.notify_all();
+		}
+
+		for (std::thread & worker : workers) { worker.join(); }
+
+		workers.clear();
+	}
+
+	~CPartitionedQuery() {
+		for (CBatch * batch : ready) { batchDestroy(batch); }
+		for (CBatch * batch : spare) { batchDestroy(batch); }
+		if (current != NULL) { batchDestroy(current); }
+	}
+};
+
+extern "C" {
+	CPartitionedQuery * _Nullable partitionedExecute(
+		CStatement * _Nonnull const * _Nonnull statements, long count, long rowsetSize,
+		long maxRows, long timeout, CError * _Nonnull error) {
+		CPartitionedQuery * query = NULL;
+
+		try {
+			query = new CPartitionedQuery;
+			query->rowsetSize = rowsetSize;
+			query->maxRows = std::max(maxRows, 1L);
+			query->timeout = timeout;
+			query->capacity = static_cast<size_t>(std::max(count, 1L)) * 2;
+			query->workers.reserve(static_cast<size_t>(std::max(count, 0L)));
+
+			for (long i = 0; i < count; i++) {
+				CStatement * stmt = statements[i];
+
+				{
+					std::lock_guard<std::mutex> guard(query->mutex);
+					query->running++;
+				}
+
+				try {
+					query->workers.emplace_back([query, stmt] { query->run(stmt); });
+				} catch (...) {
+					std::lock_guard<std::mutex> guard(query->mutex);
+					query->running--;
+					throw;
+				}
+			}
+
+			return query;
+		} catch (...) { setError(error); }
+
+		if (query != NULL) {
+			query->stop();
+			delete query;
+		}
+
+		return NULL;
+	}
+
+	const CBatch * _Nullable partitionedNext(
+		CPartitionedQuery * _Nonnull query, CError * _Nonnull error) {
+		std::unique_lock<std::mutex> lock(query->mutex);
+
+		if (query->current != NULL) {
+			query->spare.push_back(query->current);
+			query->current = NULL;
+		}
+
+		query->changed.wait(lock, [query] {
+			return !query->ready.empty() || query->running == 0 || query->failed;
+		});
+
+		if (query->failed) {
+			setError(error, query->message.c_str(), query->reason);
+			return NULL;
+		}
+
+		if (query->ready.empty()) { return NULL; }
+
+		query->current = query->ready.front();
+		query->ready.pop_front();
+		query->changed.notify_all();
+
+		return query->current;
+	}
+
+	void partitionedDestroy(CPartitionedQuery * _Nonnull query) {
+		query->stop();
+		delete query;
+	}
+}
@@ -0,0 +1,253 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Catalog/Catalog.h"
+#include "Handles.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sql.h>
+#include <sqlext.h>
+#include <vector>
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	struct PoolHandle {
+		struct Idle {
+			ConnectionHandle * conn;
+			Clock::time_point since;
+		};
+
+		std::function<nanodbc::connection()> connect;
+		size_t minSize;
+		size_t maxSize;
+		std::chrono::seconds idleTimeout;
+		nanodbc::string validationQuery;
+		// Shared by all connections of the pool, as they see the same database.
+		std::shared_ptr<MetadataCache> metadata = makeMetadataCache();
+
+		std::mutex mutex;
+		std::condition_variable released;
+		// Most recently released last, so the connections that stay idle longest are closed first.
+		std::deque<Idle> idle;
+		// Idle and acquired connections, plus those currently being opened.
+		size_t size = 0;
+	};
+
+	PoolHandle & handle(CConnectionPool * rawPool) {
+		return *reinterpret_cast<PoolHandle *>(rawPool);
+	}
+
+	// If `conn` is still usable: the driver must not report it dead, and the validation query, if
+	// any, must succeed.
+	bool isAlive(PoolHandle & pool, ConnectionHandle & conn) {
+		if (!conn.conn.connected()) { return false; }
+
+		SQLUINTEGER dead = SQL_CD_FALSE;
+		const SQLRETURN rc = SQLGetConnectAttr(
+			conn.conn.native_dbc_handle(), SQL_ATTR_CONNECTION_DEAD, &dead, 0, NULL);
+
+		if (SQL_SUCCEEDED(rc) && dead == SQL_CD_TRUE) { return false; }
+		if (pool.validationQuery.empty()) { return true; }
+
+		try {
+			nanodbc::just_execute(conn.conn, pool.validationQuery);
+			return true;
+		} catch (std::exception &) { return false; }
+	}
+
+	// Closes connections that have been idle for longer than the idle timeout, keeping at least
+	// `minSize` connections open. Returns the closed connections, which are deleted by the caller
+	// without holding the lock.
+	std::vector<ConnectionHandle *> expire(PoolHandle & pool, Clock::time_point now) {
+		std::vector<ConnectionHandle *> expired;
+
+		while (!pool.idle.empty() && pool.size > pool.minSize &&
+			   pool.idleTimeout.count() > 0 && now - pool.idle.front().since > pool.idleTimeout) {
+			expired.push_back(pool.idle.front().conn);
+			pool.idle.pop_front();
+			pool.size--;
+		}
+
+		return expired;
+	}
+
+	CConnectionPool * _Nullable createPool(
+		std::function<nanodbc::connection()> connect, CConnectionPoolOptions options,
+		CError * _Nonnull error) {
+		auto pool = new PoolHandle;
+		pool->connect = connect;
+		pool->maxSize = options.maxSize > 0 ? options.maxSize : 1;
+		pool->minSize = std::min<size_t>(std::max(options.minSize, 0L), pool->maxSize);
+		pool->idleTimeout = std::chrono::seconds(options.idleTimeout);
+		pool->validationQuery =
+			options.validationQuery != NULL ? charToString(options.validationQuery) : nanodbc::string();
+
+		try {
+			while (pool->size < pool->minSize) {
+				pool->idle.push_back(
+					PoolHandle::Idle { new ConnectionHandle(connect(), pool->metadata),
+									   Clock::now() });
+				pool->size++;
+			}
+
+			return reinterpret_cast<CConnectionPool *>(pool);
+		} catch (...) { setError(error); }
+
+		poolDestroy(reinterpret_cast<CConnectionPool *>(pool));
+		return NULL;
+	}
+}
+
+extern "C" {
+	CConnectionPool * _Nullable poolCreateConnectionString(
+		const char * _Nonnull connStr, long timeout, CConnectionPoolOptions options,
+		CError * _Nonnull error) {
+		const nanodbc::string connectionString = charToString(connStr);
+
+		return createPool(
+			[=]() { return nanodbc::connection(connectionString, timeout); }, options, error);
+	}
+
+	CConnectionPool * _Nullable poolCreateDSN(
+		const char * _Nonnull dsn, const char * _Nonnull username, const char * _Nonnull password,
+		long timeout, CConnectionPoolOptions options, CError * _Nonnull error) {
+		const nanodbc::string dataSource = charToString(dsn);
+		const nanodbc::string user = charToString(username);
+		const nanodbc::string pass = charToString(password);
+
+		return createPool(
+			[=]() { return nanodbc::connection(dataSource, user, pass, timeout); }, options, error);
+	}
+
+	CConnection * _Nullable poolAcquire(
+		CConnectionPool * _Nonnull rawPool, long waitTimeout, CError * _Nonnull error) {
+		PoolHandle & pool = handle(rawPool);
+		const auto deadline = Clock::now() + std::chrono::milliseconds(std::max(waitTimeout, 0L));
+
+		while (true) {
+			std::unique_lock<std::mutex> lock(pool.mutex);
+			auto expired = expire(pool, Clock::now());
+			ConnectionHandle * conn = NULL;
+			bool shouldConnect = false;
+
+			if (!pool.idle.empty()) {
+				conn = pool.idle.back().conn;
+				pool.idle.pop_back();
+			} else if (pool.size < pool.maxSize) {
+				pool.size++;
+				shouldConnect = true;
+			} else {
+				// Wait for a connection to be released, then try again.
+				bool timedOut = false;
+
+				if (waitTimeout < 0) {
+					pool.released.wait(lock);
+				} else {
+					timedOut = pool.released.wait_until(lock, deadline) == std::cv_status::timeout;
+				}
+
+				lock.unlock();
+				for (auto c : expired) { delete c; }
+
+				if (timedOut) {
+					setError(error, "Timed out waiting for a pooled connection", general);
+					return NULL;
+				}
+
+				continue;
+			}
+
+			lock.unlock();
+			for (auto c : expired) { delete c; }
+
+			if (shouldConnect) {
+				try {
+					return reinterpret_cast<CConnection *>(
+						new ConnectionHandle(pool.connect(), pool.metadata));
+				} catch (...) {
+					{
+						std::lock_guard<std::mutex> guard(pool.mutex);
+						pool.size--;
+					}
+					pool.released.notify_one();
+
+					setError(error);
+					return NULL;
+				}
+			}
+
+			if (isAlive(pool, *conn)) { return reinterpret_cast<CConnection *>(conn); }
+
+			// Replace the dead connection on the next iteration.
+			delete conn;
+			{
+				std::lock_guard<std::mutex> guard(pool.mutex);
+				pool.size--;
+			}
+		}
+	}
+
+	void poolRelease(CConnectionPool * _Nonnull rawPool, CConnection * _Nonnull conn) {
+		PoolHandle & pool = handle(rawPool);
+		ConnectionHandle * connection = &handle(conn);
+		std::vector<ConnectionHandle *> expired;
+
+		{
+			std::lock_guard<std::mutex> guard(pool.mutex);
+
+			if (connection->conn.connected()) {
+				pool.idle.push_back(PoolHandle::Idle { connection, Clock::now() });
+				connection = NULL;
+			} else {
+				pool.size--;
+			}
+
+			expired = expire(pool, Clock::now());
+		}
+
+		pool.released.notify_one();
+
+		delete connection;
+		for (auto c : expired) { delete c; }
+	}
+
+	CConnectionPoolStatistics poolStatistics(CConnectionPool * _Nonnull rawPool) {
+		PoolHandle & pool = handle(rawPool);
+		std::lock_guard<std::mutex> guard(pool.mutex);
+
+		return CConnectionPoolStatistics { .size = static_cast<long>(pool.size),
+										   .idle = static_cast<long>(pool.idle.size()),
+										   .maxSize = static_cast<long>(pool.maxSize) };
+	}
+
+	void poolSetMetadataCacheTTL(CConnectionPool * _Nonnull rawPool, long milliseconds) {
+		handle(rawPool).metadata->setTTL(milliseconds);
+	}
+
+	void poolInvalidateMetadataCache(
+		CConnectionPool * _Nonnull rawPool, const char * _Nullable table) {
+		handle(rawPool).metadata->invalidate(table);
+	}
+
+	CMetadataCacheStatistics poolMetadataCacheStatistics(CConnectionPool * _Nonnull rawPool) {
+		return handle(rawPool).metadata->statistics();
+	}
+
+	void poolDestroy(CConnectionPool * _Nonnull rawPool) {
+		PoolHandle * pool = &handle(rawPool);
+
+		for (auto & entry : pool->idle) { delete entry.conn; }
+
+		delete pool;
+	}
+}
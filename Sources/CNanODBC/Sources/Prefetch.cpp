@@ -0,0 +1,137 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc.h"
+#include <CNanODBC/CNanODBC.h>
+#include <CNanODBC/CxxFuncs.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Double buffering is done with two `CBatch`es rather than two sets of ODBC bindings: nanodbc binds
+// its rowset column-wise, which `SQL_ATTR_ROW_BIND_OFFSET_PTR` cannot switch between, and copying a
+// rowset into a batch is part of the work that should happen off the consumer's thread anyway.
+struct CPrefetcher {
+	CResult * result;
+	long maxRows;
+
+	std::mutex mutex;
+	std::condition_variable changed;
+
+	// `batches[filling]` is filled by the worker; the other one is the batch last handed out.
+	CBatch * batches[2] = { NULL, NULL };
+	int filling = 0;
+
+	bool requested = true;
+	bool ready = false;
+	bool stopping = false;
+	// The last batch has been handed out.
+	bool exhausted = false;
+
+	bool failed = false;
+	std::string message;
+	ErrorReason reason = general;
+
+	std::thread worker;
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+
+		for (;;) {
+			changed.wait(lock, [this] { return requested || stopping; });
+
+			if (stopping) { return; }
+
+			requested = false;
+			CBatch * reuse = batches[filling];
+			lock.unlock();
+
+			CError * error = threadError();
+			CBatch * batch = resultFetchBatch(result, maxRows, reuse, error);
+
+			lock.lock();
+
+			if (batch != NULL) { batches[filling] = batch; }
+
+			if (error->isValid) {
+				failed = true;
+				reason = error->reason;
+				message = error->message != NULL ? error->message : "Unknown error";
+			}
+
+			ready = true;
+			changed.notify_all();
+		}
+	}
+};
+
+extern "C" {
+	CPrefetcher * _Nullable resultPrefetchBatches(
+		CResult * _Nonnull rawRes, long maxRows, CError * _Nonnull error) {
+		CPrefetcher * prefetcher = NULL;
+
+		try {
+			prefetcher = new CPrefetcher;
+			prefetcher->result = rawRes;
+			prefetcher->maxRows = std::max(maxRows, 1L);
+			prefetcher->worker = std::thread([prefetcher] { prefetcher->run(); });
+
+			return prefetcher;
+		} catch (...) { setError(error); }
+
+		delete prefetcher;
+		return NULL;
+	}
+
+	const CBatch * _Nullable prefetcherNext(
+		CPrefetcher * _Nonnull prefetcher, CError * _Nonnull error) {
+		std::unique_lock<std::mutex> lock(prefetcher->mutex);
+
+		if (prefetcher->exhausted) { return NULL; }
+
+		prefetcher->changed.wait(lock, [prefetcher] { return prefetcher->ready; });
+		prefetcher->ready = false;
+
+		if (prefetcher->failed) {
+			prefetcher->exhausted = true;
+			setError(error, prefetcher->message.c_str(), prefetcher->reason);
+			return NULL;
+		}
+
+		const CBatch * batch = prefetcher->batches[prefetcher->filling];
+
+		// A short batch means `resultFetchBatch` ran out of rows, so there is nothing left to fetch.
+		if (batch->rowCount < prefetcher->maxRows) {
+			prefetcher->exhausted = true;
+			return batch->rowCount > 0 ? batch : NULL;
+		}
+
+		prefetcher->filling ^= 1;
+		prefetcher->requested = true;
+		prefetcher->changed.notify_all();
+
+		return batch;
+	}
+
+	void prefetcherDestroy(CPrefetcher * _Nonnull prefetcher) {
+		{
+			std::lock_guard<std::mutex> guard(prefetcher->mutex);
+			prefetcher->stopping = true;
+			prefetcher->changed.notify_all();
+		}
+
+		// Waits for a fetch that is still running, as it uses the result.
+		prefetcher->worker.join();
+
+		for (CBatch * batch : prefetcher->batches) {
+			if (batch != NULL) { batchDestroy(batch); }
+		}
+
+		delete prefetcher;
+	}
+}
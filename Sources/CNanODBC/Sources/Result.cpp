@@ -7,19 +7,24 @@
 #include "../nanodbc.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
+#include <algorithm>
+#include <sql.h>
+#include <sqlext.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
 extern "C" {
+	void resultDestroy(CResult * _Nonnull rawRes) {
+		delete reinterpret_cast<nanodbc::result *>(rawRes);
+	}
 
 	// MARK: - Result Information
 	long resultNumRows(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->rows();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -28,9 +33,8 @@ extern "C" {
 	short resultNumCols(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->columns();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -39,9 +43,8 @@ extern "C" {
 	long resultAffectedRows(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->affected_rows();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -52,9 +55,8 @@ extern "C" {
 	bool resultNext(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->next();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -63,9 +65,8 @@ extern "C" {
 	bool resultPrior(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->prior();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -74,9 +75,8 @@ extern "C" {
 	bool resultFirst(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->first();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -85,9 +85,8 @@ extern "C" {
 	bool resultLast(CResult * _Nonnull rawRes, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->first();
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -96,9 +95,8 @@ extern "C" {
 	bool resultMoveTo(CResult * _Nonnull rawRes, long row, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->move(row);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -107,9 +105,18 @@ extern "C" {
 	bool resultSkip(CResult * _Nonnull rawRes, long rows, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->skip(rows);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
+
+			return false;
+		}
+	}
+
+	bool resultNextResult(CResult * _Nonnull rawRes, CError * _Nonnull error) {
+		try {
+			return reinterpret_cast<nanodbc::result *>(rawRes)->next_result();
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -134,14 +141,8 @@ extern "C" {
 			}
 			return strdup(
 				reinterpret_cast<nanodbc::result *>(rawRes)->column_datatype_name(colName).c_str());
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return "";
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		} catch (...) {
+			setError(error);
 
 			return "";
 		}
@@ -155,14 +156,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->column_datatype(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->column_datatype(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return 100;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		} catch (...) {
+			setError(error);
 
 			return 100;
 		}
@@ -176,14 +171,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->is_null(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->is_null(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return 100;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -197,14 +186,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->column_size(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->column_size(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return 100;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -213,15 +196,9 @@ extern "C" {
 	const char * _Nullable resultColumnName(
 		CResult * _Nonnull rawRes, short colNum, CError * _Nonnull error) {
 		try {
-			return strdup(reinterpret_cast<nanodbc::result *>(rawRes)->column_name(colNum).c_str());
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+			return reinterpret_cast<nanodbc::result *>(rawRes)->column_name(colNum).c_str();
+		} catch (...) {
+			setError(error);
 
 			return NULL;
 		}
@@ -231,14 +208,8 @@ extern "C" {
 		CResult * _Nonnull rawRes, const char * _Nonnull colName, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<nanodbc::result *>(rawRes)->column(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -254,27 +225,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<short>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<short>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -288,27 +240,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<unsigned short>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<unsigned short>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -323,27 +256,8 @@ extern "C" {
 			}
 
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<int>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -357,27 +271,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<int64_t>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<int64_t>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -391,27 +286,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<int32_t>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<int32_t>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -425,27 +301,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<float>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<float>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -455,31 +312,20 @@ extern "C" {
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error) {
 		try {
-			if (colNum != NULL) {
-				return reinterpret_cast<nanodbc::result *>(rawRes)->get<double>(*colNum);
+			nanodbc::result & res = *reinterpret_cast<nanodbc::result *>(rawRes);
+			const short column = colNum != NULL ? *colNum : res.column(charToString(colName));
+			CDecimal decimal;
+
+			// `DECIMAL`/`NUMERIC` columns are bound as text. Parse it in place instead of copying it
+			// into a `std::string` for `std::stod`, as long as the result is correctly rounded.
+			if (boundDecimal(res, column, decimal) && decimal.high == 0 &&
+				decimal.low <= (uint64_t(1) << 53) && decimal.scale <= 22) {
+				return decimalToDouble(decimal);
 			}
-			return reinterpret_cast<nanodbc::result *>(rawRes)->get<double>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return -1;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return -1;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
 
-			return -1;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return -1;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+			return res.get<double>(column);
+		} catch (...) {
+			setError(error);
 
 			return -1;
 		}
@@ -496,29 +342,67 @@ extern "C" {
 			}
 			return strdup(
 				reinterpret_cast<nanodbc::result *>(rawRes)->get<nanodbc::string>(colName).c_str());
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+		} catch (...) {
+			setError(error);
 
 			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
+		}
+	}
 
-			return NULL;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
+	bool resultGetStringView(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		const char * _Nullable * _Nonnull data, unsigned long * _Nonnull length,
+		CError * _Nonnull error) {
+		try {
+			auto res = reinterpret_cast<nanodbc::result *>(rawRes);
+			const short column = colNum != NULL ? *colNum : res->column(colName);
+			const char * bound = res->column_bound_data(column);
 
-			return NULL;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
+			if (bound == NULL || res->column_c_datatype(column) != SQL_C_CHAR) { return false; }
 
-			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+			const long position = res->rowset_position();
+			const unsigned long size = res->column_bound_length(column);
+			const nanodbc::null_type indicator = res->column_bound_indicators(column)[position];
 
-			return NULL;
+			if (indicator == SQL_NULL_DATA) { throw nanodbc::null_access_error(); }
+
+			*data = bound + position * size;
+			*length = boundStringLength(*data, size, indicator);
+
+			return true;
+		} catch (...) {
+			setError(error);
+
+			return false;
+		}
+	}
+
+	long resultCopyString(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		char * _Nonnull buffer, unsigned long capacity, CError * _Nonnull error) {
+		try {
+			const char * data = NULL;
+			unsigned long length = 0;
+
+			if (resultGetStringView(rawRes, colNum, colName, &data, &length, error)) {
+				memcpy(buffer, data, std::min(length, capacity));
+
+				return length;
+			} else if (error->isValid) {
+				return -1;
+			}
+
+			auto res = reinterpret_cast<nanodbc::result *>(rawRes);
+			const std::string value = colNum != NULL ? res->get<std::string>(*colNum)
+													 : res->get<std::string>(colName);
+
+			memcpy(buffer, value.data(), std::min<size_t>(value.size(), capacity));
+
+			return value.size();
+		} catch (...) {
+			setError(error);
+
+			return -1;
 		}
 	}
 
@@ -536,27 +420,8 @@ extern "C" {
 			CTime * cTime = (CTime *) malloc(sizeof(CTime));
 			*cTime = CTime { .hour = time.hour, .minute = time.min, .second = time.sec };
 			return cTime;
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return NULL;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return NULL;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return NULL;
 		}
@@ -585,27 +450,8 @@ extern "C" {
 									   .second = timestamp.sec,
 									   .fractionalSec = timestamp.fract };
 			return cTimeStamp;
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return NULL;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return NULL;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return NULL;
 		}
@@ -622,28 +468,12 @@ extern "C" {
 			} else {
 				date = reinterpret_cast<nanodbc::result *>(rawRes)->get<nanodbc::date>(colName);
 			}
-			return new CDate { .month = date.month, .day = date.day, .year = date.year };
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+			CDate * cDate = (CDate *) malloc(sizeof(CDate));
 
-			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return NULL;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return NULL;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+			*cDate = CDate { .month = date.month, .day = date.day, .year = date.year };
+			return cDate;
+		} catch (...) {
+			setError(error);
 
 			return NULL;
 		}
@@ -657,27 +487,8 @@ extern "C" {
 				return reinterpret_cast<nanodbc::result *>(rawRes)->get<int>(*colNum);
 			}
 			return reinterpret_cast<nanodbc::result *>(rawRes)->get<int>(colName);
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return false;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return false;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return false;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return false;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return false;
 		}
@@ -697,34 +508,12 @@ extern "C" {
 			}
 
 			uint8_t * rawRes = (uint8_t *) malloc(sizeof(uint8_t) * res.size());
-
-			for (int i = 0; i < res.size(); i++) {
-				rawRes[i] = res[i];
-			}
+			memcpy(rawRes, res.data(), res.size());
 
 			*sizePointer = res.size();
 			return rawRes;
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
-
-			return NULL;
-		} catch (nanodbc::index_range_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = indexOutOfRange };
-
-			return NULL;
-		} catch (nanodbc::type_incompatible_error & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = invalidType };
-
-			return NULL;
-		} catch (nanodbc::null_access_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = nullAccessError };
-
-			return NULL;
-		} catch (std::exception & e) {
-			*error = CError { .isValid = true, .message = strdup(e.what()), .reason = general };
+		} catch (...) {
+			setError(error);
 
 			return NULL;
 		}
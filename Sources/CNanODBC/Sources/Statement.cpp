@@ -4,43 +4,145 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
-#include "../nanodbc.h"
+#include "Handles.h"
 #include <CNanODBC/CNanODBC.h>
 #include <CNanODBC/CxxFuncs.h>
+#include <sql.h>
+#include <sqlext.h>
 #include <string.h>
+#include <vector>
+
+namespace {
+	// Returns the statement for binding `paramIndex` to something other than its slot.
+	nanodbc::statement & rebind(CStatement * rawStmt, short paramIndex) {
+		handle(rawStmt).parameters.erase(paramIndex);
+		return statement(rawStmt);
+	}
+
+	void bindSlot(
+		CStatement * rawStmt, short paramIndex, const std::type_info & type, const void * value,
+		size_t size) {
+		auto & parameter = handle(rawStmt).parameters[paramIndex];
+
+		if (parameter.type != NULL && *parameter.type == type && parameter.capacity >= size) {
+			memcpy(parameter.storage.get(), value, size);
+			return;
+		}
+
+		// The driver may still point at the old storage if binding the new one fails, so it is only
+		// released once the new one is bound. Until then the slot is marked as not bound to it.
+		std::unique_ptr<char[]> storage(new char[size]);
+		const char * data = storage.get();
+		memcpy(storage.get(), value, size);
+		parameter.type = NULL;
+
+		if (type == typeid(char)) {
+			statement(rawStmt).bind(paramIndex, data);
+		} else if (type == typeid(short)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const short *>(data));
+		} else if (type == typeid(unsigned short)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const unsigned short *>(data));
+		} else if (type == typeid(int)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const int *>(data));
+		} else if (type == typeid(int64_t)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const int64_t *>(data));
+		} else if (type == typeid(float)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const float *>(data));
+		} else if (type == typeid(double)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const double *>(data));
+		} else if (type == typeid(nanodbc::date)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const nanodbc::date *>(data));
+		} else if (type == typeid(nanodbc::time)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const nanodbc::time *>(data));
+		} else if (type == typeid(nanodbc::timestamp)) {
+			statement(rawStmt).bind(paramIndex, reinterpret_cast<const nanodbc::timestamp *>(data));
+		}
+
+		parameter.storage = std::move(storage);
+		parameter.capacity = size;
+		parameter.type = &type;
+	}
+
+	ParameterRowStatus rowStatus(SQLUSMALLINT status) {
+		switch (status) {
+			case SQL_PARAM_SUCCESS: return succeededRow;
+			case SQL_PARAM_SUCCESS_WITH_INFO: return succeededWithInfoRow;
+			case SQL_PARAM_ERROR: return failedRow;
+			case SQL_PARAM_UNUSED: return unusedRow;
+			default: return unknownRow;
+		}
+	}
+
+	// Points the statement's `SQL_ATTR_PARAM_STATUS_PTR` at a buffer for the duration of an
+	// execution, so the driver does not keep writing to it afterwards.
+	class ParamStatusScope {
+	public:
+		ParamStatusScope(nanodbc::statement & stmt, long count)
+			: handle(stmt.native_statement_handle()), statuses(count, SQL_PARAM_DIAG_UNAVAILABLE) {
+			set(statuses.data());
+		}
+
+		~ParamStatusScope() { set(NULL); }
+
+		const std::vector<SQLUSMALLINT> & values() const { return statuses; }
+
+	private:
+		void set(SQLUSMALLINT * pointer) {
+			SQLSetStmtAttr(handle, SQL_ATTR_PARAM_STATUS_PTR, pointer, 0);
+		}
+
+		SQLHSTMT handle;
+		std::vector<SQLUSMALLINT> statuses;
+	};
+
+	template <typename T> void bindValue(CStatement * rawStmt, short paramIndex, const T & value) {
+		bindSlot(rawStmt, paramIndex, typeid(T), &value, sizeof(T));
+	}
+
+	void bindString(CStatement * rawStmt, short paramIndex, const char * value) {
+		bindSlot(rawStmt, paramIndex, typeid(char), value, strlen(value) + 1);
+	}
+}
 
 extern "C" {
 	// MARK: - Create
 	CStatement * _Nonnull stmtCreate(
 		CConnection * _Nonnull rawConn, const char * _Nonnull query, long timeout) {
-		return reinterpret_cast<CStatement *>(new nanodbc::statement(
-			*reinterpret_cast<nanodbc::connection *>(rawConn), charToString(query), timeout));
+		auto & cache = handle(rawConn).statements;
+		auto range = cache.index.equal_range(query);
+
+		for (auto entry = range.first; entry != range.second; ++entry) {
+			StatementHandle * stmt = *entry->second;
+
+			if (stmt->timeout != timeout) { continue; }
+
+			cache.entries.erase(entry->second);
+			cache.index.erase(entry);
+			cache.hits++;
+
+			return reinterpret_cast<CStatement *>(stmt);
+		}
+
+		cache.misses++;
+
+		return reinterpret_cast<CStatement *>(
+			new StatementHandle(handle(rawConn), query, timeout));
 	}
 
 	// MARK: - Bind
 
 	CError * _Nullable stmtBindNull(CStatement * _Nonnull rawStmt, short paramIndex) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind_null(paramIndex);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			rebind(rawStmt, paramIndex).bind_null(paramIndex);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
 
 	CError * _Nullable stmtBindShort(CStatement * _Nonnull rawStmt, short paramIndex, short value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -48,26 +150,16 @@ extern "C" {
 	CError * _Nullable stmtBindUnsignedShort(
 		CStatement * _Nonnull rawStmt, short paramIndex, unsigned short value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
 
 	CError * _Nullable stmtBindInt(CStatement * _Nonnull rawStmt, short paramIndex, int value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -75,12 +167,8 @@ extern "C" {
 	CError * _Nullable stmtBindBigInt(
 		CStatement * _Nonnull rawStmt, short paramIndex, int64_t value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -88,26 +176,16 @@ extern "C" {
 	CError * _Nullable stmtBindLong(
 		CStatement * _Nonnull rawStmt, short paramIndex, int32_t value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
 
 	CError * _Nullable stmtBindFloat(CStatement * _Nonnull rawStmt, short paramIndex, float value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -115,13 +193,8 @@ extern "C" {
 	CError * _Nullable stmtBindDouble(
 		CStatement * _Nonnull rawStmt, short paramIndex, double value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -129,13 +202,8 @@ extern "C" {
 	CError * _Nullable stmtBindString(
 		CStatement * _Nonnull rawStmt, short paramIndex, const char * _Nonnull value) {
 		try {
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, value);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindString(rawStmt, paramIndex, value);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -143,13 +211,8 @@ extern "C" {
 	CError * _Nullable stmtBindBool(CStatement * _Nonnull rawStmt, short paramIndex, bool value) {
 		try {
 			int v = value ? 1 : 0;
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &v);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, v);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -158,15 +221,9 @@ extern "C" {
 		CStatement * _Nonnull rawStmt, short paramIndex, const uint8_t * _Nonnull value,
 		int64_t size) {
 		try {
-			auto vec =
-				std::vector<std::vector<std::uint8_t>> { std::vector<uint8_t>(value[0], size) };
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, vec);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			auto vec = std::vector<std::vector<std::uint8_t>> { std::vector<uint8_t>(value, value + size) };
+			rebind(rawStmt, paramIndex).bind(paramIndex, vec);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -174,13 +231,8 @@ extern "C" {
 	CError * _Nullable stmtBindTime(CStatement * _Nonnull rawStmt, short paramIndex, CTime value) {
 		try {
 			auto time = cTimeToTime(value);
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &time);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, time);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -189,13 +241,8 @@ extern "C" {
 		CStatement * _Nonnull rawStmt, short paramIndex, CTimeStamp value) {
 		try {
 			auto timestamp = cTimeStampToTimestamp(value);
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &timestamp);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, timestamp);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
@@ -203,33 +250,161 @@ extern "C" {
 	CError * _Nullable stmtBindDate(CStatement * _Nonnull rawStmt, short paramIndex, CDate value) {
 		try {
 			auto date = cDateToDate(value);
-			reinterpret_cast<nanodbc::statement *>(rawStmt)->bind(paramIndex, &date);
-		} catch (nanodbc::database_error & e) {
-			return new CError { .isValid = true,
-								.message = strdup(e.what()),
-								.reason = databaseError };
-			return NULL;
-		}
+			bindValue(rawStmt, paramIndex, date);
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	// MARK: - Bind Arrays
+
+	CError * _Nullable stmtBindIntArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const int32_t * _Nonnull values, long count,
+		const bool * _Nullable nulls) {
+		try {
+			rebind(rawStmt, paramIndex).bind(paramIndex, values, count, nulls);
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	CError * _Nullable stmtBindBigIntArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const int64_t * _Nonnull values, long count,
+		const bool * _Nullable nulls) {
+		try {
+			rebind(rawStmt, paramIndex).bind(paramIndex, values, count, nulls);
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	CError * _Nullable stmtBindDoubleArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const double * _Nonnull values, long count,
+		const bool * _Nullable nulls) {
+		try {
+			rebind(rawStmt, paramIndex).bind(paramIndex, values, count, nulls);
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	CError * _Nullable stmtBindStringArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const char * _Nullable const * _Nonnull values,
+		long count, const bool * _Nullable nulls) {
+		try {
+			std::vector<std::string> strings(count);
+			std::unique_ptr<bool[]> isNull(new bool[count]);
+
+			for (long i = 0; i < count; i++) {
+				isNull[i] = values[i] == NULL || (nulls != NULL && nulls[i]);
+				if (!isNull[i]) { strings[i] = values[i]; }
+			}
+
+			rebind(rawStmt, paramIndex).bind_strings(
+				paramIndex, strings, isNull.get());
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	CError * _Nullable stmtBindBinaryArray(
+		CStatement * _Nonnull rawStmt, short paramIndex,
+		const uint8_t * _Nullable const * _Nonnull values, const int64_t * _Nonnull sizes,
+		long count, const bool * _Nullable nulls) {
+		try {
+			std::vector<std::vector<uint8_t>> bytes(count);
+			std::unique_ptr<bool[]> isNull(new bool[count]);
+
+			for (long i = 0; i < count; i++) {
+				isNull[i] = values[i] == NULL || (nulls != NULL && nulls[i]);
+				if (!isNull[i]) { bytes[i].assign(values[i], values[i] + sizes[i]); }
+			}
+
+			rebind(rawStmt, paramIndex).bind(paramIndex, bytes, isNull.get());
+		} catch (...) { return threadErrorFromException(); }
+
+		return NULL;
+	}
+
+	CError * _Nullable stmtBindNullArray(CStatement * _Nonnull rawStmt, short paramIndex, long count) {
+		try {
+			rebind(rawStmt, paramIndex).bind_null(paramIndex, count);
+		} catch (...) { return threadErrorFromException(); }
 
 		return NULL;
 	}
 
 	// MARK: - Execute
 	CResult * _Nullable stmtExecute(
-		CStatement * _Nonnull rawStmt, long timeout, CError * _Nonnull error) {
+		CStatement * _Nonnull rawStmt, long rowsetSize, long timeout, CError * _Nonnull error) {
 		try {
 			return reinterpret_cast<CResult *>(
-				new nanodbc::result(reinterpret_cast<nanodbc::statement *>(rawStmt)->execute()));
-		} catch (nanodbc::database_error & e) {
-			*error =
-				CError { .isValid = true, .message = strdup(e.what()), .reason = databaseError };
+				new nanodbc::result(statement(rawStmt).execute(1, timeout, rowsetSize)));
+		} catch (...) {
+			setError(error);
+
+			return NULL;
+		}
+
+		return NULL;
+	}
+
+	CResult * _Nullable stmtExecuteBatch(
+		CStatement * _Nonnull rawStmt, long batchOperations, long timeout, CError * _Nonnull error) {
+		try {
+			return reinterpret_cast<CResult *>(
+				new nanodbc::result(statement(rawStmt).execute(batchOperations, timeout)));
+		} catch (...) {
+			setError(error);
+
 			return NULL;
 		}
 
 		return NULL;
 	}
 
+	CResult * _Nullable stmtExecuteBatchWithStatus(
+		CStatement * _Nonnull rawStmt, long batchOperations, long timeout,
+		ParameterRowStatus * _Nonnull statuses, CError * _Nonnull error) {
+		try {
+			nanodbc::statement & stmt = statement(rawStmt);
+			ParamStatusScope scope(stmt, batchOperations);
+			CResult * res = NULL;
+
+			try {
+				res = reinterpret_cast<CResult *>(
+					new nanodbc::result(stmt.execute(batchOperations, timeout)));
+			} catch (...) { setError(error); }
+
+			// Drivers report the status of each row even if some of them failed.
+			for (long i = 0; i < batchOperations; i++) { statuses[i] = rowStatus(scope.values()[i]); }
+
+			return res;
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
 	void stmtClose(CStatement * _Nonnull rawStmt) {
-		reinterpret_cast<nanodbc::statement *>(rawStmt)->close();
+		handle(rawStmt).parameters.clear();
+		statement(rawStmt).close();
+	}
+
+	void stmtDestroy(CStatement * _Nonnull rawStmt) {
+		StatementHandle * stmt = &handle(rawStmt);
+		auto & cache = stmt->owner.statements;
+
+		if (cache.capacity == 0 || !stmt->stmt.open()) {
+			delete stmt;
+			return;
+		}
+
+		// Keep the statement prepared, but forget its parameters like a new statement would.
+		stmt->parameters.clear();
+		stmt->stmt.reset_parameters();
+
+		cache.entries.push_front(stmt);
+		cache.index.emplace(stmt->query, cache.entries.begin());
+		cache.trim();
 	}
 }
@@ -0,0 +1,133 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "Handles.h"
+#include <chrono>
+#include <sql.h>
+#include <sqlext.h>
+
+// Transactions nest through nanodbc's per-connection transaction count: only the outermost one
+// turns autocommit off and ends the transaction on the server, inner ones just take part in it.
+
+struct CCommitBatcher {
+	CCommitBatcher(CConnection * rawConn, long statements, long milliseconds)
+		: transaction(connection(rawConn)), statements(statements),
+		  interval(std::chrono::milliseconds(milliseconds)),
+		  started(std::chrono::steady_clock::now()) {}
+
+	nanodbc::transaction transaction;
+	const long statements;
+	const std::chrono::milliseconds interval;
+
+	long pending = 0;
+	std::chrono::steady_clock::time_point started;
+
+	bool due() const {
+		return (statements > 0 && pending >= statements) ||
+			   (interval.count() > 0 && std::chrono::steady_clock::now() - started >= interval);
+	}
+
+	// Commits the pending statements while keeping the transaction, and with it autocommit being
+	// off, open. Inside an enclosing transaction nothing can be committed before it is.
+	void commit() {
+		nanodbc::connection & conn = transaction.connection();
+
+		if (conn.transactions() == 1) {
+			if (conn.rollback_pending()) {
+				throw nanodbc::programming_error("The transaction has been rolled back");
+			}
+
+			const RETCODE rc = SQLEndTran(SQL_HANDLE_DBC, conn.native_dbc_handle(), SQL_COMMIT);
+
+			if (!SQL_SUCCEEDED(rc)) {
+				throw nanodbc::database_error(conn.native_dbc_handle(), SQL_HANDLE_DBC);
+			}
+		}
+
+		pending = 0;
+		started = std::chrono::steady_clock::now();
+	}
+};
+
+namespace {
+	nanodbc::transaction & transaction(CTransaction * rawTransaction) {
+		return *reinterpret_cast<nanodbc::transaction *>(rawTransaction);
+	}
+}
+
+extern "C" {
+	CTransaction * _Nullable transactionBegin(
+		CConnection * _Nonnull rawConn, CError * _Nonnull error) {
+		try {
+			return reinterpret_cast<CTransaction *>(new nanodbc::transaction(connection(rawConn)));
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	bool transactionCommit(CTransaction * _Nonnull rawTransaction, CError * _Nonnull error) {
+		try {
+			nanodbc::transaction & t = transaction(rawTransaction);
+
+			// nanodbc would commit the work of a rolled back transaction along with the rest.
+			if (t.connection().transactions() == 1 && t.connection().rollback_pending()) {
+				throw nanodbc::programming_error("The transaction has been rolled back");
+			}
+
+			t.commit();
+			return true;
+		} catch (...) { setError(error); }
+
+		return false;
+	}
+
+	void transactionRollback(CTransaction * _Nonnull rawTransaction) {
+		transaction(rawTransaction).rollback();
+	}
+
+	void transactionDestroy(CTransaction * _Nonnull rawTransaction) {
+		delete reinterpret_cast<nanodbc::transaction *>(rawTransaction);
+	}
+
+	CCommitBatcher * _Nullable commitBatcherCreate(
+		CConnection * _Nonnull rawConn, long statements, long milliseconds,
+		CError * _Nonnull error) {
+		try {
+			return new CCommitBatcher(rawConn, statements, milliseconds);
+		} catch (...) { setError(error); }
+
+		return NULL;
+	}
+
+	bool commitBatcherCount(
+		CCommitBatcher * _Nonnull batcher, long statements, CError * _Nonnull error) {
+		try {
+			batcher->pending += statements;
+
+			if (batcher->due()) {
+				batcher->commit();
+				return true;
+			}
+		} catch (...) { setError(error); }
+
+		return false;
+	}
+
+	bool commitBatcherFlush(CCommitBatcher * _Nonnull batcher, CError * _Nonnull error) {
+		try {
+			batcher->commit();
+			return true;
+		} catch (...) { setError(error); }
+
+		return false;
+	}
+
+	bool commitBatcherFinish(CCommitBatcher * _Nonnull batcher, CError * _Nonnull error) {
+		return transactionCommit(reinterpret_cast<CTransaction *>(&batcher->transaction), error);
+	}
+
+	void commitBatcherDestroy(CCommitBatcher * _Nonnull batcher) { delete batcher; }
+}
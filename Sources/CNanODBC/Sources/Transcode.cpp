@@ -0,0 +1,38 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+#include "../nanodbc_utf.h"
+#include <CNanODBC/CNanODBC.h>
+
+namespace {
+	nanodbc::utf::implementation implementation(TranscodeImplementation impl) {
+		switch (impl) {
+			case scalarTranscoder: return nanodbc::utf::implementation::scalar;
+			case codecvtTranscoder: return nanodbc::utf::implementation::codecvt;
+			default: return nanodbc::utf::implementation::best;
+		}
+	}
+
+	long written(size_t count) {
+		return count == nanodbc::utf::npos ? -1 : static_cast<long>(count);
+	}
+}
+
+extern "C" {
+	long transcodeUTF16ToUTF8(
+		const uint16_t * _Nonnull in, unsigned long length, char * _Nonnull out,
+		TranscodeImplementation impl) {
+		return written(nanodbc::utf::utf16_to_utf8(
+			reinterpret_cast<const char16_t *>(in), length, out, implementation(impl)));
+	}
+
+	long transcodeUTF8ToUTF16(
+		const char * _Nonnull in, unsigned long length, uint16_t * _Nonnull out,
+		TranscodeImplementation impl) {
+		return written(nanodbc::utf::utf8_to_utf16(
+			in, length, reinterpret_cast<char16_t *>(out), implementation(impl)));
+	}
+}
@@ -25,12 +25,30 @@ extern "C" {
 	struct CConnection;
 	typedef struct CConnection CConnection;
 
+	struct CConnectionPool;
+	typedef struct CConnectionPool CConnectionPool;
+
 	struct CResult;
 	typedef struct CResult CResult;
 
 	struct CStatement;
 	typedef struct CStatement CStatement;
 
+	struct CBlob;
+	typedef struct CBlob CBlob;
+
+	struct CPrefetcher;
+	typedef struct CPrefetcher CPrefetcher;
+
+	struct CPartitionedQuery;
+	typedef struct CPartitionedQuery CPartitionedQuery;
+
+	struct CTransaction;
+	typedef struct CTransaction CTransaction;
+
+	struct CCommitBatcher;
+	typedef struct CCommitBatcher CCommitBatcher;
+
 	struct CCatalog;
 	typedef struct CCatalog CCatalog;
 
@@ -96,6 +114,14 @@ extern "C" {
 
 	typedef struct CError CError;
 
+	/// Clears and returns the calling thread's error record.
+	///
+	/// Pass it as the `error` of any function to have failures reported without allocating; the
+	/// function's return value is only meaningful if `isValid` is still `false` afterwards.
+	/// Functions that return a `CError *` return this record as well. Its message is owned by the
+	/// record, must not be freed, and stays valid until the next error on the same thread.
+	CError * _Nonnull threadError(void);
+
 	struct CDate {
 		int16_t month;
 		int16_t day;
@@ -122,6 +148,282 @@ extern "C" {
 
 	typedef struct CTimeStamp CTimeStamp;
 
+	/// An exact decimal number: `(negative ? -1 : 1) * (high * 2^64 + low) * 10^-scale`.
+	///
+	/// Holds up to 38 significant digits, the maximum precision of `SQL_NUMERIC_STRUCT`, with a
+	/// scale between 0 and 38.
+	struct CDecimal {
+		uint64_t low;
+		uint64_t high;
+		int16_t scale;
+		bool negative;
+	};
+
+	typedef struct CDecimal CDecimal;
+
+	/// The size of a buffer that fits any `CDecimal` formatted by `decimalFormat`, including the
+	/// null terminator.
+	#define DECIMAL_STRING_CAPACITY 42
+
+	enum BatchColumnType {
+		int64Column,
+		doubleColumn,
+		dateColumn,
+		timeColumn,
+		timeStampColumn,
+		stringColumn,
+		binaryColumn
+	} __attribute__((enum_extensibility(open)));
+
+	typedef enum BatchColumnType BatchColumnType;
+
+	/// The outcome of one row of parameters of a batch execution.
+	enum ParameterRowStatus {
+		succeededRow,
+		succeededWithInfoRow,
+		failedRow,
+		// The row was not executed, because an earlier row failed.
+		unusedRow,
+		// The driver did not report the outcome of the row.
+		unknownRow
+	} __attribute__((enum_extensibility(open)));
+
+	typedef enum ParameterRowStatus ParameterRowStatus;
+
+	enum TranscodeImplementation {
+		// The fastest implementation supported by the running CPU.
+		bestTranscoder,
+		// The portable implementation, without SIMD instructions.
+		scalarTranscoder,
+		// `std::wstring_convert`, which nanodbc used before.
+		codecvtTranscoder
+	} __attribute__((enum_extensibility(open)));
+
+	typedef enum TranscodeImplementation TranscodeImplementation;
+
+	/// One column of a `CBatch`.
+	///
+	/// `values` points to `rowCount` `int64_t`, `double`, `CDate`, `CTime` or `CTimeStamp` values
+	/// depending on `type`. For `stringColumn` and `binaryColumn` it points to the concatenated
+	/// bytes of all rows instead, and row `i` is `values[offsets[i]..<offsets[i + 1]]`. Bit `i % 8`
+	/// of `validity[i / 8]` is set if row `i` is not null.
+	struct CBatchColumn {
+		BatchColumnType type;
+		const void * _Nullable values;
+		const int64_t * _Nullable offsets;
+		const uint8_t * _Nonnull validity;
+	};
+
+	typedef struct CBatchColumn CBatchColumn;
+
+	struct CBatch {
+		long rowCount;
+		short columnCount;
+		const CBatchColumn * _Nullable columns;
+	};
+
+	typedef struct CBatch CBatch;
+
+	// The Arrow C data interface, as specified in
+	// https://arrow.apache.org/docs/format/CDataInterface.html and
+	// https://arrow.apache.org/docs/format/CStreamInterface.html.
+#ifndef ARROW_C_DATA_INTERFACE
+	#define ARROW_C_DATA_INTERFACE
+
+	#define ARROW_FLAG_DICTIONARY_ORDERED 1
+	#define ARROW_FLAG_NULLABLE 2
+	#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+	struct ArrowSchema {
+		const char * _Nonnull format;
+		const char * _Nullable name;
+		const char * _Nullable metadata;
+		int64_t flags;
+		int64_t n_children;
+		struct ArrowSchema * _Nonnull * _Nullable children;
+		struct ArrowSchema * _Nullable dictionary;
+		void (*_Nullable release)(struct ArrowSchema * _Nonnull);
+		void * _Nullable private_data;
+	};
+
+	struct ArrowArray {
+		int64_t length;
+		int64_t null_count;
+		int64_t offset;
+		int64_t n_buffers;
+		int64_t n_children;
+		const void * _Nullable * _Nullable buffers;
+		struct ArrowArray * _Nonnull * _Nullable children;
+		struct ArrowArray * _Nullable dictionary;
+		void (*_Nullable release)(struct ArrowArray * _Nonnull);
+		void * _Nullable private_data;
+	};
+#endif
+
+#ifndef ARROW_C_STREAM_INTERFACE
+	#define ARROW_C_STREAM_INTERFACE
+
+	struct ArrowArrayStream {
+		int (*_Nullable get_schema)(struct ArrowArrayStream * _Nonnull, struct ArrowSchema * _Nonnull);
+		int (*_Nullable get_next)(struct ArrowArrayStream * _Nonnull, struct ArrowArray * _Nonnull);
+		const char * _Nullable (*_Nullable get_last_error)(struct ArrowArrayStream * _Nonnull);
+		void (*_Nullable release)(struct ArrowArrayStream * _Nonnull);
+		void * _Nullable private_data;
+	};
+#endif
+
+	struct CStatementCacheStatistics {
+		long capacity;
+		/// The amount of prepared statements currently waiting to be reused.
+		long size;
+		/// The amount of `stmtCreate` calls that reused a prepared statement.
+		long hits;
+		/// The amount of `stmtCreate` calls that prepared a new statement.
+		long misses;
+	};
+
+	typedef struct CStatementCacheStatistics CStatementCacheStatistics;
+
+	struct CMetadataCacheStatistics {
+		/// The amount of milliseconds a catalog lookup is kept for. 0 means the cache is off.
+		long ttl;
+		/// The amount of catalog lookups currently cached.
+		long size;
+		/// The amount of catalog lookups that were answered from the cache.
+		long hits;
+		/// The amount of catalog lookups that had to query the driver.
+		long misses;
+	};
+
+	typedef struct CMetadataCacheStatistics CMetadataCacheStatistics;
+
+	/// A row of `SQLColumns`. Columns that are `NULL` are empty strings, respectively 0.
+	struct CCatalogColumn {
+		const char * _Nonnull tableCatalog;
+		const char * _Nonnull tableSchema;
+		const char * _Nonnull tableName;
+		const char * _Nonnull name;
+		const char * _Nonnull typeName;
+		const char * _Nonnull remarks;
+		const char * _Nonnull defaultValue;
+		const char * _Nonnull isNullable;
+		long columnSize;
+		long bufferLength;
+		long charOctetLength;
+		long ordinalPosition;
+		short dataType;
+		short decimalDigits;
+		short numericPrecisionRadix;
+		short nullable;
+		short sqlDataType;
+		short sqlDateTimeSubType;
+	};
+
+	typedef struct CCatalogColumn CCatalogColumn;
+
+	/// A row of `SQLTables`.
+	struct CCatalogTable {
+		const char * _Nonnull tableCatalog;
+		const char * _Nonnull tableSchema;
+		const char * _Nonnull tableName;
+		/// "TABLE", "VIEW", "SYSTEM TABLE" or another type specific to the database.
+		const char * _Nonnull tableType;
+		const char * _Nonnull remarks;
+	};
+
+	typedef struct CCatalogTable CCatalogTable;
+
+	/// A row of `SQLTablePrivileges`.
+	struct CCatalogTablePrivilege {
+		const char * _Nonnull tableCatalog;
+		const char * _Nonnull tableSchema;
+		const char * _Nonnull tableName;
+		const char * _Nonnull grantor;
+		const char * _Nonnull grantee;
+		const char * _Nonnull privilege;
+		/// "YES", "NO", or empty if unknown.
+		const char * _Nonnull isGrantable;
+	};
+
+	typedef struct CCatalogTablePrivilege CCatalogTablePrivilege;
+
+	/// A row of `SQLPrimaryKeys`.
+	struct CCatalogPrimaryKey {
+		const char * _Nonnull tableCatalog;
+		const char * _Nonnull tableSchema;
+		const char * _Nonnull tableName;
+		const char * _Nonnull columnName;
+		const char * _Nonnull primaryKeyName;
+		/// The 1-based position of the column in the key.
+		short columnNumber;
+	};
+
+	typedef struct CCatalogPrimaryKey CCatalogPrimaryKey;
+
+	/// A row of `SQLProcedures`.
+	struct CCatalogProcedure {
+		const char * _Nonnull procedureCatalog;
+		const char * _Nonnull procedureSchema;
+		const char * _Nonnull procedureName;
+		const char * _Nonnull remarks;
+		/// `SQL_PT_PROCEDURE`, `SQL_PT_FUNCTION` or `SQL_PT_UNKNOWN`.
+		short procedureType;
+	};
+
+	typedef struct CCatalogProcedure CCatalogProcedure;
+
+	/// A row of `SQLProcedureColumns`.
+	struct CCatalogProcedureColumn {
+		const char * _Nonnull procedureCatalog;
+		const char * _Nonnull procedureSchema;
+		const char * _Nonnull procedureName;
+		const char * _Nonnull columnName;
+		const char * _Nonnull typeName;
+		const char * _Nonnull remarks;
+		const char * _Nonnull defaultValue;
+		const char * _Nonnull isNullable;
+		long columnSize;
+		long bufferLength;
+		long charOctetLength;
+		long ordinalPosition;
+		/// `SQL_PARAM_INPUT`, `SQL_RESULT_COL`, `SQL_RETURN_VALUE` and so on.
+		short columnType;
+		short dataType;
+		short decimalDigits;
+		short numericPrecisionRadix;
+		short nullable;
+		short sqlDataType;
+		short sqlDateTimeSubType;
+	};
+
+	typedef struct CCatalogProcedureColumn CCatalogProcedureColumn;
+
+	struct CConnectionPoolOptions {
+		/// The amount of connections that are opened up front and kept open while idle.
+		long minSize;
+		/// The maximum amount of open connections, including acquired ones.
+		long maxSize;
+		/// The amount of seconds after which idle connections above `minSize` are closed. 0 keeps
+		/// them open.
+		long idleTimeout;
+		/// A query run on an idle connection before handing it out, or `NULL` to only ask the
+		/// driver if the connection is dead.
+		const char * _Nullable validationQuery;
+	};
+
+	typedef struct CConnectionPoolOptions CConnectionPoolOptions;
+
+	struct CConnectionPoolStatistics {
+		/// The amount of open connections, including acquired ones.
+		long size;
+		/// The amount of open connections that are not acquired.
+		long idle;
+		/// The maximum amount of open connections, after clamping `CConnectionPoolOptions.maxSize`.
+		long maxSize;
+	};
+
+	typedef struct CConnectionPoolStatistics CConnectionPoolStatistics;
+
 	// MARK: - Connection
 	CConnection * _Nullable createConnectionConnectionString(
 		const char * _Nonnull connStr, long timeout, CError * _Nonnull error);
@@ -135,6 +437,80 @@ extern "C" {
 	CError * _Nullable connectionDisconnect(CConnection * _Nonnull conn);
 	void destroyConnection(CConnection * _Nonnull conn);
 
+	/// Sets how many prepared statements `conn` keeps for reuse by `stmtCreate` once they are
+	/// destroyed. 0 disables the cache.
+	void connectionSetStatementCacheCapacity(CConnection * _Nonnull conn, long capacity);
+	CStatementCacheStatistics connectionStatementCacheStatistics(CConnection * _Nonnull conn);
+
+	/// Sets how many milliseconds the catalog lookups of `conn` are cached for. 0 disables the
+	/// cache. Connections acquired from a pool share the pool's cache.
+	void connectionSetMetadataCacheTTL(CConnection * _Nonnull conn, long milliseconds);
+	/// Drops the cached column lookups that may have found columns of `table`, or every cached
+	/// lookup if `table` is `NULL`.
+	void connectionInvalidateMetadataCache(
+		CConnection * _Nonnull conn, const char * _Nullable table);
+	CMetadataCacheStatistics connectionMetadataCacheStatistics(CConnection * _Nonnull conn);
+
+	// MARK: - Transaction
+
+	// Transactions on the same connection nest: only the outermost one turns autocommit off and
+	// commits on the server; committing an inner one just ends its part. Rolling back, or
+	// destroying an uncommitted transaction, rolls back the outermost one when it ends, whose
+	// commit then fails.
+
+	CTransaction * _Nullable transactionBegin(CConnection * _Nonnull rawConn, CError * _Nonnull error);
+	bool transactionCommit(CTransaction * _Nonnull rawTransaction, CError * _Nonnull error);
+	void transactionRollback(CTransaction * _Nonnull rawTransaction);
+	/// Rolls back `rawTransaction` if it has not been committed.
+	void transactionDestroy(CTransaction * _Nonnull rawTransaction);
+
+	/// Begins a transaction on `rawConn` that `commitBatcherCount` commits every `statements`
+	/// statements, or once `milliseconds` have passed since the last commit. Either limit is off if
+	/// it is 0. Within an enclosing transaction, statements are only committed along with it.
+	CCommitBatcher * _Nullable commitBatcherCreate(
+		CConnection * _Nonnull rawConn, long statements, long milliseconds,
+		CError * _Nonnull error);
+
+	/// Counts `statements` more executed statements. Returns `true` if they have been committed.
+	bool commitBatcherCount(
+		CCommitBatcher * _Nonnull batcher, long statements, CError * _Nonnull error);
+
+	/// Commits the statements counted since the last commit, keeping the transaction open.
+	bool commitBatcherFlush(CCommitBatcher * _Nonnull batcher, CError * _Nonnull error);
+
+	/// Commits the remaining statements and ends the transaction.
+	bool commitBatcherFinish(CCommitBatcher * _Nonnull batcher, CError * _Nonnull error);
+
+	/// Rolls back the statements since the last commit unless `commitBatcherFinish` was called.
+	void commitBatcherDestroy(CCommitBatcher * _Nonnull batcher);
+
+	// MARK: - Connection Pool
+
+	// Connection pools are thread-safe. Connections acquired from a pool must be returned with
+	// `poolRelease` instead of being destroyed, and all of them must be released before the pool
+	// is destroyed.
+
+	CConnectionPool * _Nullable poolCreateConnectionString(
+		const char * _Nonnull connStr, long timeout, CConnectionPoolOptions options,
+		CError * _Nonnull error);
+	CConnectionPool * _Nullable poolCreateDSN(
+		const char * _Nonnull dsn, const char * _Nonnull username, const char * _Nonnull password,
+		long timeout, CConnectionPoolOptions options, CError * _Nonnull error);
+
+	/// Hands out an idle connection, or opens a new one if fewer than `maxSize` are open. Otherwise
+	/// waits up to `waitTimeout` milliseconds for a connection to be released; a negative
+	/// `waitTimeout` waits indefinitely.
+	CConnection * _Nullable poolAcquire(
+		CConnectionPool * _Nonnull rawPool, long waitTimeout, CError * _Nonnull error);
+	void poolRelease(CConnectionPool * _Nonnull rawPool, CConnection * _Nonnull conn);
+	CConnectionPoolStatistics poolStatistics(CConnectionPool * _Nonnull rawPool);
+	/// Like `connectionSetMetadataCacheTTL`, for the cache all connections of the pool share.
+	void poolSetMetadataCacheTTL(CConnectionPool * _Nonnull rawPool, long milliseconds);
+	void poolInvalidateMetadataCache(
+		CConnectionPool * _Nonnull rawPool, const char * _Nullable table);
+	CMetadataCacheStatistics poolMetadataCacheStatistics(CConnectionPool * _Nonnull rawPool);
+	void poolDestroy(CConnectionPool * _Nonnull rawPool);
+
 	// MARK: - List
 	const CDriver * _Null_unspecified listDrivers(unsigned long * _Nonnull cDriverArraySize);
 	const CDataSource * _Null_unspecified listDataSources(
@@ -146,9 +522,43 @@ extern "C" {
 		long timeout, CError * _Nonnull error);
 	CResult * _Nullable cExecute(
 		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
-		long timeout, CError * _Nonnull error);
+		long rowsetSize, long timeout, CError * _Nonnull error);
+
+	// MARK: - Async
+
+	/// Called once an asynchronous call has finished, on the I/O thread that ran it. `error` is
+	/// `NULL` on success, and otherwise the error record of that thread, only valid during the call.
+	typedef void (*CResultCompletion)(
+		void * _Nullable context, CResult * _Nullable result, const CError * _Nullable error);
+	typedef void (*CBoolCompletion)(
+		void * _Nullable context, bool value, const CError * _Nullable error);
+
+	// These run the blocking function of the same name on an I/O thread and return immediately,
+	// calling `completion` with `context` once it has finished. I/O threads are started on demand,
+	// so no call waits for another one to finish, and exit after being idle for a while. Do not
+	// use the handle passed to them until `completion` has been called.
+
+	void justExecuteAsync(
+		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
+		long timeout, void * _Nullable context, CBoolCompletion _Nonnull completion);
+	void cExecuteAsync(
+		CConnection * _Nonnull rawConn, const char * _Nonnull query, long batchOperations,
+		long rowsetSize, long timeout, void * _Nullable context,
+		CResultCompletion _Nonnull completion);
+	void stmtExecuteAsync(
+		CStatement * _Nonnull rawStmt, long rowsetSize, long timeout, void * _Nullable context,
+		CResultCompletion _Nonnull completion);
+	/// Moving to a row of the rowset that has already been fetched does not need the driver, so
+	/// `completion` is called before `resultNextAsync` returns.
+	void resultNextAsync(
+		CResult * _Nonnull rawRes, void * _Nullable context, CBoolCompletion _Nonnull completion);
 
 	// MARK: - Result
+
+	/// Destroys a result returned by `cExecute` or one of the `stmtExecute` functions. The result
+	/// keeps its statement, and with it the connection, open until then. Blobs and Arrow streams
+	/// opened from it stay valid.
+	void resultDestroy(CResult * _Nonnull rawRes);
 	long resultNumRows(CResult * _Nonnull rawRes, CError * _Nonnull error);
 	short resultNumCols(CResult * _Nonnull rawRes, CError * _Nonnull error);
 	long resultAffectedRows(CResult * _Nonnull rawRes, CError * _Nonnull error);
@@ -158,6 +568,12 @@ extern "C" {
 	bool resultLast(CResult * _Nonnull rawRes, CError * _Nonnull error);
 	bool resultMoveTo(CResult * _Nonnull rawRes, long row, CError * _Nonnull error);
 	bool resultSkip(CResult * _Nonnull rawRes, long rows, CError * _Nonnull error);
+
+	/// Moves to the next result set of a query that returns several, before its first row. Returns
+	/// `false` if there are no more result sets. The columns are only bound again if their types
+	/// differ from those of the previous result set.
+	bool resultNextResult(CResult * _Nonnull rawRes, CError * _Nonnull error);
+
 	unsigned long resultPosition(CResult * _Nonnull rawRes);
 	bool resultAtEnd(CResult * _Nonnull rawRes);
 	const char * _Nonnull resultDataTypeName(
@@ -172,6 +588,8 @@ extern "C" {
 	long resultColumnSize(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+	/// The returned name belongs to the result and stays valid until it moves to the next result
+	/// set.
 	const char * _Nullable resultColumnName(
 		CResult * _Nonnull rawRes, short colNum, CError * _Nonnull error);
 	short resultColumnIndex(
@@ -200,26 +618,183 @@ extern "C" {
 	const char * _Nullable resultGetString(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+
+	/// Points `data` at the characters of a string column in the current row without copying
+	/// them. `data` is not null-terminated and stays valid until the result is moved.
+	///
+	/// Returns `false` without setting `error` if the column is not bound as narrow character data,
+	/// in which case use `resultCopyString` or `resultGetString` instead.
+	bool resultGetStringView(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		const char * _Nullable * _Nonnull data, unsigned long * _Nonnull length,
+		CError * _Nonnull error);
+
+	/// Copies up to `capacity` bytes of a string column in the current row into `buffer`, without
+	/// a null terminator.
+	///
+	/// Returns the full length of the string, which is larger than `capacity` if it was truncated,
+	/// or `-1` if an error occurred.
+	long resultCopyString(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		char * _Nonnull buffer, unsigned long capacity, CError * _Nonnull error);
+	/// The returned value is allocated on every call and has to be freed with `free`; prefer
+	/// `resultGetTimeInto`.
 	CTime * _Nullable resultGetTime(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+	/// The returned value is allocated on every call and has to be freed with `free`; prefer
+	/// `resultGetTimeStampInto`.
 	CTimeStamp * _Nullable resultGetTimeStamp(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+	/// The returned value is allocated on every call and has to be freed with `free`; prefer
+	/// `resultGetDateInto`.
 	CDate * _Nullable resultGetDate(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+	/// Writes the value to `out` instead of allocating it. Returns `false` if an error occurred.
+	bool resultGetTimeInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CTime * _Nonnull out, CError * _Nonnull error);
+	/// Writes the value to `out` instead of allocating it. Returns `false` if an error occurred.
+	bool resultGetTimeStampInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CTimeStamp * _Nonnull out, CError * _Nonnull error);
+	/// Writes the value to `out` instead of allocating it. Returns `false` if an error occurred.
+	bool resultGetDateInto(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CDate * _Nonnull out, CError * _Nonnull error);
+	/// Converts the timestamps of `column` from the current row to the end of the current rowset
+	/// into microseconds since 1970-01-01 00:00:00, in a single pass over the bound
+	/// `SQL_C_TIMESTAMP` buffer. An unbound column only yields the current row.
+	///
+	/// At most `capacity` values are written to `out`. Null values are written as 0, and bit
+	/// `i % 8` of `validity[i / 8]` is set if value `i` is not null; `validity` must hold
+	/// `(capacity + 7) / 8` bytes. `rawRes` is left on the last converted row, so the next
+	/// `resultNext` continues after it.
+	///
+	/// Returns the amount of values written, 0 if there is no current row, or -1 if an error
+	/// occurred.
+	long resultGetEpochMicroseconds(
+		CResult * _Nonnull rawRes, short column, int64_t * _Nonnull out, uint8_t * _Nonnull validity,
+		long capacity, CError * _Nonnull error);
 	bool resultGetBool(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		CError * _Nonnull error);
+	/// Reads a `DECIMAL`/`NUMERIC` (or any numeric text) column exactly. Bound columns are parsed
+	/// straight from the fetched text, without going through a `std::string` or the C locale.
+	CDecimal resultGetDecimal(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CError * _Nonnull error);
 	uint8_t * _Nullable resultGetBinary(
 		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
 		unsigned long * _Nonnull sizePointer, CError * _Nonnull error);
 
+	// MARK: - Blob
+
+	/// Opens the value of an unbound (long data) column in the current row of `rawRes` for reading
+	/// it piece by piece with `resultReadBlob`, instead of all at once with `resultGetBinary` or
+	/// `resultGetString`. Free the blob with `blobDestroy`.
+	CBlob * _Nullable resultOpenBlob(
+		CResult * _Nonnull rawRes, const short * _Nullable colNum, const char * _Nullable colName,
+		CError * _Nonnull error);
+
+	/// Reads the next up to `length` bytes of `blob` into `buffer`, with a single `SQLGetData`
+	/// call. Character data is returned in the driver's encoding, without a null terminator.
+	///
+	/// Returns the amount of bytes read, 0 once the whole value has been read or if it is null, or
+	/// -1 if an error occurred.
+	long resultReadBlob(
+		CBlob * _Nonnull blob, void * _Nonnull buffer, unsigned long length,
+		CError * _Nonnull error);
+
+	/// If the value of `blob` is null. Only known after the first `resultReadBlob`.
+	bool blobIsNull(CBlob * _Nonnull blob);
+
+	/// The amount of bytes of `blob` that have not been read yet, or -1 if the driver does not
+	/// report it. Only known after the first `resultReadBlob`.
+	long long blobRemainingLength(CBlob * _Nonnull blob);
+
+	void blobDestroy(CBlob * _Nonnull blob);
+
+	// MARK: - Batch
+
+	/// Advances `rawRes` by up to `maxRows` rows and returns their values column by column.
+	///
+	/// Pass a batch returned by a previous call as `reuse` to refill it in place. Free the batch
+	/// with `batchDestroy`.
+	CBatch * _Nullable resultFetchBatch(
+		CResult * _Nonnull rawRes, long maxRows, CBatch * _Nullable reuse,
+		CError * _Nonnull error);
+	void batchDestroy(CBatch * _Nonnull batch);
+
+	/// The type `resultFetchBatch` stores the values of `column` of `rawRes` as.
+	BatchColumnType resultColumnBatchType(
+		CResult * _Nonnull rawRes, short column, CError * _Nonnull error);
+
+	/// Starts fetching batches of up to `maxRows` rows of `rawRes` on a thread of its own. Each
+	/// `prefetcherNext` hands out the batch fetched in the background and starts fetching the next
+	/// one, so the driver's latency overlaps with the caller's processing of the batch.
+	///
+	/// `rawRes` must not be used until the prefetcher has been destroyed with `prefetcherDestroy`.
+	CPrefetcher * _Nullable resultPrefetchBatches(
+		CResult * _Nonnull rawRes, long maxRows, CError * _Nonnull error);
+
+	/// Waits for the next batch. Returns `NULL` at the end of the result or if an error occurred.
+	/// The batch is owned by `prefetcher` and stays valid until the next call.
+	const CBatch * _Nullable prefetcherNext(
+		CPrefetcher * _Nonnull prefetcher, CError * _Nonnull error);
+	void prefetcherDestroy(CPrefetcher * _Nonnull prefetcher);
+
+	// MARK: - Partitioned Query
+
+	/// Executes each of the `count` `statements` on a thread of its own and reads their results in
+	/// batches of up to `maxRows` rows. The statements must belong to different connections, have
+	/// their parameters bound, and not be used until the query has been destroyed.
+	CPartitionedQuery * _Nullable partitionedExecute(
+		CStatement * _Nonnull const * _Nonnull statements, long count, long rowsetSize,
+		long maxRows, long timeout, CError * _Nonnull error);
+
+	/// Waits for the next batch of any of the statements, in the order they are read. Returns
+	/// `NULL` once all results have been read, or if an error occurred in any of them. The batch is
+	/// owned by `query` and stays valid until the next call.
+	const CBatch * _Nullable partitionedNext(
+		CPartitionedQuery * _Nonnull query, CError * _Nonnull error);
+
+	/// Stops reading the results and waits for the statements' threads to finish.
+	void partitionedDestroy(CPartitionedQuery * _Nonnull query);
+
+	// MARK: - Arrow
+
+	/// Describes the columns of `rawRes` as an Arrow struct schema with one nullable child per
+	/// column.
+	bool resultExportArrowSchema(
+		CResult * _Nonnull rawRes, struct ArrowSchema * _Nonnull out, CError * _Nonnull error);
+
+	/// Exports the rest of the current rowset of `rawRes` (fetching the next one if it has been
+	/// consumed) as an Arrow struct array matching `resultExportArrowSchema`.
+	///
+	/// Returns `false` at the end of the result or if an error occurred. Fixed-width columns are
+	/// handed over without copying, so the values of the exported rows can no longer be read
+	/// through `rawRes`.
+	bool resultExportArrowBatch(
+		CResult * _Nonnull rawRes, struct ArrowArray * _Nonnull out, CError * _Nonnull error);
+
+	/// Exports `rawRes` as an Arrow stream of one record batch per rowset. The stream keeps its own
+	/// reference to the result.
+	void resultExportArrowStream(CResult * _Nonnull rawRes, struct ArrowArrayStream * _Nonnull out);
+
 	// MARK: - Statement
 
+	/// Prepares `query`, or reuses a statement of `rawConn`'s cache that was prepared for the same
+	/// query with the same `timeout`.
 	CStatement * _Nonnull stmtCreate(
 		CConnection * _Nonnull rawConn, const char * _Nonnull query, long timeout);
+
+	// The single-value `stmtBind*` functions copy their value into storage owned by the statement,
+	// so the statement can be executed again after binding new values. Binding a value of the same
+	// type as before only overwrites that storage without rebinding the parameter.
+
 	CError * _Nullable stmtBindNull(CStatement * _Nonnull rawStmt, short paramIndex);
 	CError * _Nullable stmtBindShort(CStatement * _Nonnull rawStmt, short paramIndex, short value);
 	CError * _Nullable stmtBindUnsignedShort(
@@ -241,22 +816,153 @@ extern "C" {
 	CError * _Nullable stmtBindTimeStamp(
 		CStatement * _Nonnull rawStmt, short paramIndex, CTimeStamp value);
 	CError * _Nullable stmtBindDate(CStatement * _Nonnull rawStmt, short paramIndex, CDate value);
+
+	// MARK: - Statement - Bind Arrays
+
+	// These bind `count` values to a parameter for a single `stmtExecuteBatch`. `nulls`, if not
+	// `NULL`, marks the values that should be bound as null. Numeric arrays are bound in place and
+	// must stay valid until the statement is executed; strings and binary values are copied.
+
+	CError * _Nullable stmtBindIntArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const int32_t * _Nonnull values, long count,
+		const bool * _Nullable nulls);
+	CError * _Nullable stmtBindBigIntArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const int64_t * _Nonnull values, long count,
+		const bool * _Nullable nulls);
+	CError * _Nullable stmtBindDoubleArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const double * _Nonnull values, long count,
+		const bool * _Nullable nulls);
+	CError * _Nullable stmtBindStringArray(
+		CStatement * _Nonnull rawStmt, short paramIndex, const char * _Nullable const * _Nonnull values,
+		long count, const bool * _Nullable nulls);
+	CError * _Nullable stmtBindBinaryArray(
+		CStatement * _Nonnull rawStmt, short paramIndex,
+		const uint8_t * _Nullable const * _Nonnull values, const int64_t * _Nonnull sizes,
+		long count, const bool * _Nullable nulls);
+	CError * _Nullable stmtBindNullArray(CStatement * _Nonnull rawStmt, short paramIndex, long count);
+
 	CResult * _Nullable stmtExecute(
-		CStatement * _Nonnull rawStmt, long timeout, CError * _Nonnull error);
+		CStatement * _Nonnull rawStmt, long rowsetSize, long timeout, CError * _Nonnull error);
+
+	/// Executes `rawStmt` once for each of the first `batchOperations` values bound with the
+	/// `stmtBind*Array` functions.
+	CResult * _Nullable stmtExecuteBatch(
+		CStatement * _Nonnull rawStmt, long batchOperations, long timeout, CError * _Nonnull error);
+
+	/// Like `stmtExecuteBatch`, also writing the outcome of each of the `batchOperations` rows to
+	/// `statuses`, whether or not the execution failed.
+	CResult * _Nullable stmtExecuteBatchWithStatus(
+		CStatement * _Nonnull rawStmt, long batchOperations, long timeout,
+		ParameterRowStatus * _Nonnull statuses, CError * _Nonnull error);
+
 	void stmtClose(CStatement * _Nonnull rawStmt);
+	void stmtDestroy(CStatement * _Nonnull rawStmt);
+
+	// MARK: - Decimal
+
+	/// Parses `length` bytes of decimal text such as `-123.4500` or `1.5E3`. Returns `false` if
+	/// `text` is not a number or does not fit into a `CDecimal`.
+	bool decimalParse(const char * _Nonnull text, unsigned long length, CDecimal * _Nonnull out);
+
+	/// Writes `decimal` to `buffer`, which must hold `DECIMAL_STRING_CAPACITY` bytes, with exactly
+	/// `scale` fractional digits and a null terminator. Returns the length of the text.
+	unsigned long decimalFormat(CDecimal decimal, char * _Nonnull buffer);
+
+	/// The closest `double` to `decimal`.
+	double decimalToDouble(CDecimal decimal);
+
+	/// `decimal` with trailing fractional zeros removed, so equal numbers have equal fields.
+	CDecimal decimalNormalized(CDecimal decimal);
+
+	// MARK: - Transcoding
+
+	// The UTF-8 <-> UTF-16 transcoders nanodbc uses for `SQL_WCHAR` data when built with
+	// `NANODBC_ENABLE_UNICODE`, exposed for benchmarks.
+	//
+	// `out` must have room for `3 * length` bytes, respectively `length` code units. Both return
+	// the amount written to `out`, or -1 if the input is malformed.
+	long transcodeUTF16ToUTF8(
+		const uint16_t * _Nonnull in, unsigned long length, char * _Nonnull out,
+		TranscodeImplementation implementation);
+	long transcodeUTF8ToUTF16(
+		const char * _Nonnull in, unsigned long length, uint16_t * _Nonnull out,
+		TranscodeImplementation implementation);
 
 	// MARK - Catalog
 
+	// Lookups are answered from the connection's metadata cache while it is on, see
+	// `connectionSetMetadataCacheTTL`.
+	//
+	// The `catalogFind*` functions read all rows of the lookup at once. The rows returned by the
+	// matching `*Array` function are contiguous, and their strings all live in one block; both
+	// stay valid until the returned object is destroyed. Strings that are `NULL` in the result of
+	// the lookup are empty, and numbers 0.
+
 	CCatalog * _Nonnull catalogCreate(CConnection * _Nonnull conn);
+	void catalogDestroy(CCatalog * _Nonnull catalog);
+	/// The returned array and its strings are a single allocation, to be freed with
+	/// `catalogListDestroy`.
 	char * _Nonnull * _Nullable catalogListCatalogs(
 		CCatalog * _Nonnull catalog, unsigned long * _Nonnull arraySize, CError * _Nonnull error);
 	char * _Nonnull * _Nullable catalogListSchemas(
 		CCatalog * _Nonnull catalog, unsigned long * _Nonnull arraySize, CError * _Nonnull error);
+	void catalogListDestroy(char * _Nonnull * _Nonnull list);
 	CColumns * _Nullable catalogFindColumns(
 		CCatalog * _Nonnull catalogPointer, const char * _Nonnull column,
-		const char * _Nonnull table, const char * _Nonnull schema, const char * _Nonnull catalog);
+		const char * _Nonnull table, const char * _Nonnull schema, const char * _Nonnull catalog,
+		CError * _Nonnull error);
+
+	// MARK: - Catalog - Tables
+	CTables * _Nullable catalogFindTables(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table, const char * _Nonnull type,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error);
+	const CCatalogTable * _Nullable catalogTablesArray(
+		CTables * _Nonnull tables, unsigned long * _Nonnull count);
+	void catalogTablesDestroy(CTables * _Nonnull tables);
+
+	// MARK: - Catalog - Table Privileges
+	/// `catalog` is not a search pattern.
+	CTablePrivileges * _Nullable catalogFindTablePrivileges(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error);
+	const CCatalogTablePrivilege * _Nullable catalogTablePrivilegesArray(
+		CTablePrivileges * _Nonnull privileges, unsigned long * _Nonnull count);
+	void catalogTablePrivilegesDestroy(CTablePrivileges * _Nonnull privileges);
+
+	// MARK: - Catalog - Primary Keys
+	CPrimaryKeys * _Nullable catalogFindPrimaryKeys(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull table,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error);
+	const CCatalogPrimaryKey * _Nullable catalogPrimaryKeysArray(
+		CPrimaryKeys * _Nonnull keys, unsigned long * _Nonnull count);
+	void catalogPrimaryKeysDestroy(CPrimaryKeys * _Nonnull keys);
+
+	// MARK: - Catalog - Procedures
+	CProcedures * _Nullable catalogFindProcedures(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull procedure,
+		const char * _Nonnull schema, const char * _Nonnull catalog, CError * _Nonnull error);
+	const CCatalogProcedure * _Nullable catalogProceduresArray(
+		CProcedures * _Nonnull procedures, unsigned long * _Nonnull count);
+	void catalogProceduresDestroy(CProcedures * _Nonnull procedures);
+
+	// MARK: - Catalog - Procedure Columns
+	CProcedureColumns * _Nullable catalogFindProcedureColumns(
+		CCatalog * _Nonnull catalogPointer, const char * _Nonnull column,
+		const char * _Nonnull procedure, const char * _Nonnull schema,
+		const char * _Nonnull catalog, CError * _Nonnull error);
+	const CCatalogProcedureColumn * _Nullable catalogProcedureColumnsArray(
+		CProcedureColumns * _Nonnull columns, unsigned long * _Nonnull count);
+	void catalogProcedureColumnsDestroy(CProcedureColumns * _Nonnull columns);
 
 	// MARK: - Catalog - Columns
+
+	// Reading a row at a time: the strings returned by the accessors belong to `columns` and stay
+	// valid until it is destroyed.
+
+	/// All rows of `columns` at once, regardless of the current row.
+	const CCatalogColumn * _Nullable catalogColumnsArray(
+		CColumns * _Nonnull columns, unsigned long * _Nonnull count);
+	void catalogColumnsDestroy(CColumns * _Nonnull columns);
 	long catalogColumnBufferLength(CColumns * _Nonnull columns);
 	long catalogColumnCharOctetLength(CColumns * _Nonnull columns);
 	const char * _Nonnull catalogColumnDefault(CColumns * _Nonnull columns);
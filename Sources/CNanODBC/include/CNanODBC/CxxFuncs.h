@@ -13,11 +13,38 @@
 	#include "CNanODBC.h"
 	#include <string>
 
-std::string charToString(const char * string);
+// Reports an error through `error`. If `error` is the calling thread's record (see
+// `threadError`), the message is copied into it without allocating; any other `CError` receives
+// a `strdup`ed message it owns.
+void setError(CError * error, const char * message, ErrorReason reason) noexcept;
+
+// Reports the exception currently being handled through `error`, mapping nanodbc's exception
+// types to an `ErrorReason`. Must only be called from a `catch` block.
+void setError(CError * error) noexcept;
+
+// Like `setError(CError *)`, for functions that return their error: reports the exception
+// currently being handled in the calling thread's record and returns it.
+CError * threadErrorFromException() noexcept;
+
+// Converts a UTF-8 string from Swift to the string type nanodbc was built with.
+nanodbc::string charToString(const char * string);
 
 nanodbc::date cDateToDate(CDate date);
 nanodbc::time cTimeToTime(CTime time);
 
 nanodbc::timestamp cTimeStampToTimestamp(CTimeStamp ts);
+
+int32_t daysSinceEpoch(int16_t year, int16_t month, int16_t day);
+int64_t microsecondsSinceEpoch(const nanodbc::timestamp & ts);
+
+bool parseDecimal(const char * text, size_t length, CDecimal & out);
+
+// Parses the bound text of `column` in the current row of `res` into `out`. Returns `false` if
+// the column is not bound as `SQL_C_CHAR`, or if its text is not a number that fits into a
+// `CDecimal`; the caller then has to fall back to `get`.
+// Throws `nanodbc::null_access_error` if the value is null.
+bool boundDecimal(nanodbc::result & res, short column, CDecimal & out);
+
+size_t boundStringLength(const char * value, unsigned long length, nanodbc::null_type indicator);
 #endif
 #endif /* Header_h */
@@ -14,6 +14,7 @@
 #endif
 
 #include "nanodbc.h"
+#include "nanodbc_utf.h"
 
 #include <algorithm>
 #include <clocale>
@@ -25,6 +26,7 @@
 #include <iomanip>
 #include <map>
 #include <type_traits>
+#include <unordered_map>
 
 #ifndef __clang__
 #include <cstdint>
@@ -275,20 +277,14 @@ inline void convert(wide_char_t const* beg, size_t n, std::string& out)
 #ifdef NANODBC_ENABLE_BOOST
     using boost::locale::conv::utf_to_utf;
     out = utf_to_utf<char>(beg, beg + n);
-#elif defined(_MSC_VER) && (_MSC_VER == 1900)
-    // Workaround for confirmed bug in VS2015. See:
-    // https://connect.microsoft.com/VisualStudio/Feedback/Details/1403302
-    // https://social.msdn.microsoft.com/Forums/en-US/8f40dcd8-c67f-4eba-9134-a19b9178e481/vs-2015-rc-linker-stdcodecvt-error
-    // Why static? http://stackoverflow.com/questions/26196686/utf8-utf16-codecvt-poor-performance
-    static thread_local std::wstring_convert<NANODBC_CODECVT_TYPE<unsigned short>, unsigned short>
-        converter;
-    out = converter.to_bytes(
-        reinterpret_cast<unsigned short const*>(beg),
-        reinterpret_cast<unsigned short const*>(beg + n));
-#else
+#elif defined(NANODBC_USE_IODBC_WIDE_STRINGS)
     static thread_local std::wstring_convert<NANODBC_CODECVT_TYPE<wide_char_t>, wide_char_t>
         converter;
     out = converter.to_bytes(beg, beg + n);
+#else
+    // UTF-16, which is wide_char_t on both Windows (wchar_t) and everywhere else (char16_t).
+    static_assert(sizeof(wide_char_t) == sizeof(char16_t), "wide_char_t must be UTF-16");
+    nanodbc::utf::utf16_to_utf8(reinterpret_cast<char16_t const*>(beg), n, out);
 #endif
 }
 
@@ -297,20 +293,18 @@ inline void convert(char const* beg, size_t n, wide_string& out)
 #ifdef NANODBC_ENABLE_BOOST
     using boost::locale::conv::utf_to_utf;
     out = utf_to_utf<wide_char_t>(beg, beg + n);
-#elif defined(_MSC_VER) && (_MSC_VER == 1900)
-    // Workaround for confirmed bug in VS2015. See:
-    // https://connect.microsoft.com/VisualStudio/Feedback/Details/1403302
-    // https://social.msdn.microsoft.com/Forums/en-US/8f40dcd8-c67f-4eba-9134-a19b9178e481/vs-2015-rc-linker-stdcodecvt-error
-    // Why static? http://stackoverflow.com/questions/26196686/utf8-utf16-codecvt-poor-performance
-    static thread_local std::wstring_convert<NANODBC_CODECVT_TYPE<unsigned short>, unsigned short>
-        converter;
-    auto s = converter.from_bytes(beg, beg + n);
-    auto p = reinterpret_cast<wide_char_t const*>(s.data());
-    out.assign(p, p + s.size());
-#else
+#elif defined(NANODBC_USE_IODBC_WIDE_STRINGS)
     static thread_local std::wstring_convert<NANODBC_CODECVT_TYPE<wide_char_t>, wide_char_t>
         converter;
     out = converter.from_bytes(beg, beg + n);
+#else
+    static_assert(sizeof(wide_char_t) == sizeof(char16_t), "wide_char_t must be UTF-16");
+    out.resize(n);
+    auto const written = nanodbc::utf::utf8_to_utf16(
+        beg, n, reinterpret_cast<char16_t*>(&out[0]));
+    if (written == nanodbc::utf::npos)
+        throw std::range_error("convert: invalid UTF-8");
+    out.resize(written);
 #endif
 }
 
@@ -1589,6 +1583,24 @@ public:
         return result(statement, batch_operations);
     }
 
+    result execute_direct(
+        class connection& conn,
+        const string& query,
+        long batch_operations,
+        long timeout,
+        long rowset_size,
+        statement& statement)
+    {
+#ifdef NANODBC_ENABLE_WORKAROUND_NODATA
+        const RETCODE rc = just_execute_direct(conn, query, batch_operations, timeout, statement);
+        if (rc == SQL_NO_DATA)
+            return result();
+#else
+        just_execute_direct(conn, query, batch_operations, timeout, statement);
+#endif
+        return result(statement, rowset_size);
+    }
+
     RETCODE just_execute_direct(
         class connection& conn,
         const string& query,
@@ -1639,6 +1651,18 @@ public:
         return result(statement, batch_operations);
     }
 
+    result execute(long batch_operations, long timeout, long rowset_size, statement& statement)
+    {
+#ifdef NANODBC_ENABLE_WORKAROUND_NODATA
+        const RETCODE rc = just_execute(batch_operations, timeout, statement);
+        if (rc == SQL_NO_DATA)
+            return result();
+#else
+        just_execute(batch_operations, timeout, statement);
+#endif
+        return result(statement, rowset_size);
+    }
+
     RETCODE just_execute(
         long batch_operations,
         long timeout,
@@ -2285,6 +2309,8 @@ public:
         , bound_columns_(0)
         , bound_columns_size_(0)
         , rowset_position_(0)
+        , chunked_column_(-1)
+        , chunked_row_(0)
         , bound_columns_by_name_()
         , at_end_(false)
 #if defined(NANODBC_DO_ASYNC_IMPL)
@@ -2479,14 +2505,13 @@ public:
 
     short column(const string& column_name) const
     {
-        typedef std::map<string, bound_column*>::const_iterator iter;
-        iter i = bound_columns_by_name_.find(column_name);
+        auto i = bound_columns_by_name_.find(column_name);
         if (i == bound_columns_by_name_.end())
             throw index_range_error();
-        return i->second->column_;
+        return i->second;
     }
 
-    string column_name(short column) const
+    const string& column_name(short column) const
     {
         throw_if_column_is_out_of_range(column);
         return bound_columns_[column].name_;
@@ -2578,6 +2603,110 @@ public:
         return col.ctype_;
     }
 
+    const char* column_bound_data(short column) const
+    {
+        throw_if_column_is_out_of_range(column);
+        bound_column& col = bound_columns_[column];
+        return col.bound_ ? col.pdata_ : nullptr;
+    }
+
+    const null_type* column_bound_indicators(short column) const
+    {
+        throw_if_column_is_out_of_range(column);
+        return bound_columns_[column].cbdata_;
+    }
+
+    unsigned long column_bound_length(short column) const
+    {
+        throw_if_column_is_out_of_range(column);
+        bound_column& col = bound_columns_[column];
+        NANODBC_ASSERT(col.clen_ <= static_cast<SQLULEN>(std::numeric_limits<unsigned long>::max()));
+        return static_cast<unsigned long>(col.clen_);
+    }
+
+    long rowset_position() const noexcept { return rowset_position_; }
+
+    std::unique_ptr<char[]> release_bound_data(short column)
+    {
+        throw_if_column_is_out_of_range(column);
+        bound_column& col = bound_columns_[column];
+        if (!col.bound_)
+            return nullptr;
+
+        std::unique_ptr<char[]> replacement(new char[rowset_size_ * col.clen_]);
+        RETCODE rc;
+        NANODBC_CALL_RC(
+            SQLBindCol,
+            rc,
+            stmt_.native_statement_handle(),
+            column + 1,
+            col.ctype_,
+            replacement.get(),
+            col.clen_,
+            col.cbdata_); // Re-use existing cbdata_ buffer
+        if (!success(rc))
+            NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
+
+        std::unique_ptr<char[]> released(col.pdata_);
+        col.pdata_ = replacement.release();
+        return released;
+    }
+
+    bool get_data_chunk(
+        short column,
+        void* buffer,
+        std::size_t buffer_size,
+        std::size_t& written,
+        null_type& indicator)
+    {
+        throw_if_column_is_out_of_range(column);
+        bound_column& col = bound_columns_[column];
+        if (col.bound_)
+            throw programming_error("get_data_chunk: column is bound");
+
+#if defined(NANODBC_DO_ASYNC_IMPL)
+        stmt_.disable_async();
+#endif
+
+        // Positioning the cursor restarts SQLGetData, so only do it for the first chunk.
+        if (chunked_column_ != column || chunked_row_ != rowset_position_)
+        {
+            position_for_get_data();
+            chunked_column_ = column;
+            chunked_row_ = rowset_position_;
+        }
+
+        written = 0;
+        SQLLEN ValueLenOrInd = 0;
+        RETCODE rc;
+        NANODBC_CALL_RC(
+            SQLGetData,
+            rc,
+            stmt_.native_statement_handle(),
+            column + 1,
+            SQL_C_BINARY,
+            buffer,
+            static_cast<SQLLEN>(buffer_size),
+            &ValueLenOrInd);
+        if (rc == SQL_NO_DATA)
+            return false;
+        if (!success(rc))
+            NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
+
+        indicator = ValueLenOrInd;
+        if (ValueLenOrInd == SQL_NULL_DATA)
+        {
+            col.cbdata_[static_cast<size_t>(rowset_position_)] = (SQLINTEGER)SQL_NULL_DATA;
+            return false;
+        }
+
+        written = ValueLenOrInd == SQL_NO_TOTAL
+                      ? buffer_size
+                      : std::min<std::size_t>(ValueLenOrInd, buffer_size);
+        // The driver reports truncation, i.e. that more data is left, with SQL_SUCCESS_WITH_INFO.
+        return rc == SQL_SUCCESS_WITH_INFO;
+    }
+
     bool next_result()
     {
         RETCODE rc;
@@ -2591,7 +2720,64 @@ public:
             return false;
         if (!success(rc))
             NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
-        auto_bind();
+
+        rowset_position_ = 0;
+        row_count_ = 0;
+        at_end_ = false;
+
+        // Column bindings stay in effect across result sets, so a result set with the same
+        // columns as the previous one reuses its buffers instead of binding new ones.
+        if (same_columns())
+            before_move();
+        else
+            auto_bind();
+        return true;
+    }
+
+    // Returns true if the columns of the current result set have the same types and sizes as
+    // the bound ones, taking over their names if they do.
+    bool same_columns()
+    {
+        const short n_columns = columns();
+        if (n_columns != bound_columns_size_)
+            return false;
+
+        RETCODE rc;
+        NANODBC_SQLCHAR column_name[1024];
+        SQLSMALLINT sqltype = 0, scale = 0, nullable = 0, len = 0;
+        SQLULEN sqlsize = 0;
+        std::vector<string> names;
+        names.reserve(n_columns);
+
+        for (SQLSMALLINT i = 0; i < n_columns; ++i)
+        {
+            NANODBC_CALL_RC(
+                NANODBC_FUNC(SQLDescribeCol),
+                rc,
+                stmt_.native_statement_handle(),
+                i + 1,
+                (NANODBC_SQLCHAR*)column_name,
+                sizeof(column_name) / sizeof(NANODBC_SQLCHAR),
+                &len,
+                &sqltype,
+                &sqlsize,
+                &scale,
+                &nullable);
+            if (!success(rc))
+                NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
+
+            const bound_column& col = bound_columns_[i];
+            if (col.sqltype_ != sqltype || col.sqlsize_ != sqlsize || col.scale_ != scale)
+                return false;
+            names.emplace_back(reinterpret_cast<string::value_type*>(column_name));
+        }
+
+        bound_columns_by_name_.clear();
+        for (short i = 0; i < n_columns; ++i)
+        {
+            bound_columns_[i].name_ = std::move(names[i]);
+            bound_columns_by_name_[bound_columns_[i].name_] = i;
+        }
         return true;
     }
 
@@ -2731,8 +2917,88 @@ private:
             throw index_range_error();
     }
 
+    // With a block cursor (rowset size > 1) SQLGetData reads from the row the cursor is
+    // positioned on, which is the first row of the rowset unless we move it explicitly.
+    void position_for_get_data() const
+    {
+        if (rowset_size_ <= 1)
+            return;
+
+        RETCODE rc;
+        NANODBC_CALL_RC(
+            SQLSetPos,
+            rc,
+            stmt_.native_statement_handle(),
+            static_cast<SQLSETPOSIROW>(rowset_position_ + 1),
+            SQL_POSITION,
+            SQL_LOCK_NO_CHANGE);
+        if (!success(rc))
+            NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
+    }
+
+    // Reads the whole value of the unbound column with SQLGetData as ctype, SQL_C_CHAR or
+    // SQL_C_BINARY, and appends it to out. The first read asks for 1 KiB; if the driver then
+    // reports how much is left, all of it is read with the next call, otherwise every further
+    // read is twice as large as the one before. Returns the result of the last SQLGetData call.
+    template <class Bytes>
+    RETCODE get_data_all(short column, SQLSMALLINT ctype, Bytes& out) const
+    {
+        bound_column& col = bound_columns_[column];
+        std::size_t const terminator = ctype == SQL_C_CHAR ? 1 : 0;
+        std::size_t chunk = 1024;
+        // The length of the data available to return, decreasing with subsequent SQLGetData
+        // calls.
+        // But, NOT the length of data returned into the buffer (apart from the final call).
+        SQLLEN ValueLenOrInd;
+        RETCODE rc;
+
+#if defined(NANODBC_DO_ASYNC_IMPL)
+        stmt_.disable_async();
+#endif
+
+        position_for_get_data();
+        void* handle = native_statement_handle();
+        do
+        {
+            std::size_t const offset = out.size();
+            out.resize(offset + chunk + terminator);
+            NANODBC_CALL_RC(
+                SQLGetData,
+                rc,
+                handle,                                   // StatementHandle
+                column + 1,                               // Col_or_Param_Num
+                ctype,                                    // TargetType
+                &out[offset],                             // TargetValuePtr
+                static_cast<SQLLEN>(chunk + terminator),  // BufferLength
+                &ValueLenOrInd);                          // StrLen_or_IndPtr
+            if (!success(rc))
+            {
+                out.resize(offset);
+                break;
+            }
+
+            std::size_t filled = 0;
+            if (ValueLenOrInd == SQL_NO_TOTAL)
+                filled = chunk;
+            else if (ValueLenOrInd > 0)
+                filled = std::min<std::size_t>(ValueLenOrInd, chunk);
+            else if (ValueLenOrInd == SQL_NULL_DATA)
+                col.cbdata_[static_cast<size_t>(rowset_position_)] = (SQLINTEGER)SQL_NULL_DATA;
+            out.resize(offset + filled);
+
+            if (ValueLenOrInd != SQL_NO_TOTAL && ValueLenOrInd > static_cast<SQLLEN>(chunk))
+                chunk = static_cast<std::size_t>(ValueLenOrInd) - chunk;
+            else
+                chunk *= 2;
+            // Sequence of successful calls is:
+            // SQL_NO_DATA or SQL_SUCCESS_WITH_INFO followed by SQL_SUCCESS.
+        } while (rc == SQL_SUCCESS_WITH_INFO);
+        return rc;
+    }
+
     void before_move() noexcept
     {
+        chunked_column_ = -1;
         for (short i = 0; i < bound_columns_size_; ++i)
         {
             bound_column& col = bound_columns_[i];
@@ -2801,6 +3067,7 @@ private:
         NANODBC_ASSERT(!bound_columns_size_);
         bound_columns_ = new bound_column[n_columns];
         bound_columns_size_ = n_columns;
+        bound_columns_by_name_.reserve(n_columns);
 
         RETCODE rc;
         NANODBC_SQLCHAR column_name[1024];
@@ -2853,7 +3120,7 @@ private:
             col.sqltype_ = sqltype;
             col.sqlsize_ = sqlsize;
             col.scale_ = scale;
-            bound_columns_by_name_[col.name_] = &col;
+            bound_columns_by_name_[col.name_] = i;
 
             using namespace std; // if int64_t is in std namespace (in c++11)
             switch (col.sqltype_)
@@ -2988,7 +3255,11 @@ private:
     bound_column* bound_columns_;
     short bound_columns_size_;
     long rowset_position_;
-    std::map<string, bound_column*> bound_columns_by_name_;
+    // The column, and row within the rowset, that get_data_chunk is reading; -1 if none.
+    short chunked_column_;
+    long chunked_row_;
+    // Built once by auto_bind so that by-name access costs a single hash lookup.
+    std::unordered_map<string, short> bound_columns_by_name_;
     bool at_end_;
 #if defined(NANODBC_DO_ASYNC_IMPL)
     bool async_; // true if statement is currently in SQL_STILL_EXECUTING mode
@@ -3070,43 +3341,7 @@ inline void result::result_impl::get_ref_impl(short column, T& result) const
         {
             // Input is always std::string, while output may be std::string or wide_string
             std::string out;
-            // The length of the data available to return, decreasing with subsequent SQLGetData
-            // calls.
-            // But, NOT the length of data returned into the buffer (apart from the final call).
-            SQLLEN ValueLenOrInd;
-            SQLRETURN rc;
-
-#if defined(NANODBC_DO_ASYNC_IMPL)
-            stmt_.disable_async();
-#endif
-
-            void* handle = native_statement_handle();
-            do
-            {
-                char buffer[1024] = {0};
-                const std::size_t buffer_size = sizeof(buffer);
-                NANODBC_CALL_RC(
-                    SQLGetData,
-                    rc,
-                    handle,          // StatementHandle
-                    column + 1,      // Col_or_Param_Num
-                    col.ctype_,      // TargetType
-                    buffer,          // TargetValuePtr
-                    buffer_size,     // BufferLength
-                    &ValueLenOrInd); // StrLen_or_IndPtr
-                if (ValueLenOrInd == SQL_NO_TOTAL)
-                    out.append(buffer, col.ctype_ == SQL_C_BINARY ? buffer_size : buffer_size - 1);
-                else if (ValueLenOrInd > 0)
-                    out.append(
-                        buffer,
-                        std::min<std::size_t>(
-                            ValueLenOrInd,
-                            col.ctype_ == SQL_C_BINARY ? buffer_size : buffer_size - 1));
-                else if (ValueLenOrInd == SQL_NULL_DATA)
-                    col.cbdata_[static_cast<size_t>(rowset_position_)] = (SQLINTEGER)SQL_NULL_DATA;
-                // Sequence of successful calls is:
-                // SQL_NO_DATA or SQL_SUCCESS_WITH_INFO followed by SQL_SUCCESS.
-            } while (rc == SQL_SUCCESS_WITH_INFO);
+            RETCODE const rc = get_data_all(column, static_cast<SQLSMALLINT>(col.ctype_), out);
             if (rc == SQL_SUCCESS || rc == SQL_NO_DATA)
                 convert(std::move(out), result);
             else if (!success(rc))
@@ -3137,6 +3372,7 @@ inline void result::result_impl::get_ref_impl(short column, T& result) const
             stmt_.disable_async();
 #endif
 
+            position_for_get_data();
             void* handle = native_statement_handle();
             do
             {
@@ -3308,42 +3544,7 @@ inline void result::result_impl::get_ref_impl<std::vector<std::uint8_t>>(
         {
             // Input and output is always array of bytes.
             std::vector<std::uint8_t> out;
-            std::uint8_t buffer[1024] = {0};
-            std::size_t const buffer_size = sizeof(buffer);
-            // The length of the data available to return, decreasing with subsequent SQLGetData
-            // calls.
-            // But, NOT the length of data returned into the buffer (apart from the final call).
-            SQLLEN ValueLenOrInd;
-            SQLRETURN rc;
-
-#if defined(NANODBC_DO_ASYNC_IMPL)
-            stmt_.disable_async();
-#endif
-
-            void* handle = native_statement_handle();
-            do
-            {
-                NANODBC_CALL_RC(
-                    SQLGetData,
-                    rc,
-                    handle,          // StatementHandle
-                    column + 1,      // Col_or_Param_Num
-                    SQL_C_BINARY,    // TargetType
-                    buffer,          // TargetValuePtr
-                    buffer_size,     // BufferLength
-                    &ValueLenOrInd); // StrLen_or_IndPtr
-                if (ValueLenOrInd > 0)
-                {
-                    auto const buffer_size_filled =
-                        std::min<std::size_t>(ValueLenOrInd, buffer_size);
-                    NANODBC_ASSERT(buffer_size_filled <= buffer_size);
-                    out.insert(std::end(out), buffer, buffer + buffer_size_filled);
-                }
-                else if (ValueLenOrInd == SQL_NULL_DATA)
-                    col.cbdata_[static_cast<size_t>(rowset_position_)] = (SQLINTEGER)SQL_NULL_DATA;
-                // Sequence of successful calls is:
-                // SQL_NO_DATA or SQL_SUCCESS_WITH_INFO followed by SQL_SUCCESS.
-            } while (rc == SQL_SUCCESS_WITH_INFO);
+            RETCODE const rc = get_data_all(column, SQL_C_BINARY, out);
             if (rc == SQL_SUCCESS || rc == SQL_NO_DATA)
                 result = std::move(out);
             else if (!success(rc))
@@ -3439,6 +3640,7 @@ T* result::result_impl::ensure_pdata(short column) const
         return (T*)(col.pdata_ + rowset_position_ * col.clen_);
     }
 
+    position_for_get_data();
     T* buffer = new T;
     const std::size_t buffer_size = sizeof(T);
     void* handle = native_statement_handle();
@@ -3851,6 +4053,11 @@ bool connection::rollback() const
     return impl_->rollback();
 }
 
+bool connection::rollback_pending() const
+{
+    return impl_->rollback();
+}
+
 void connection::rollback(bool onoff)
 {
     impl_->rollback(onoff);
@@ -4052,6 +4259,16 @@ result statement::execute_direct(
     return impl_->execute_direct(conn, query, batch_operations, timeout, *this);
 }
 
+result statement::execute_direct(
+    class connection& conn,
+    const string& query,
+    long batch_operations,
+    long timeout,
+    long rowset_size)
+{
+    return impl_->execute_direct(conn, query, batch_operations, timeout, rowset_size, *this);
+}
+
 #if defined(NANODBC_DO_ASYNC_IMPL)
 bool statement::async_prepare(const string& query, void* event_handle, long timeout)
 {
@@ -4113,6 +4330,11 @@ result statement::execute(long batch_operations, long timeout)
     return impl_->execute(batch_operations, timeout, *this);
 }
 
+result statement::execute(long batch_operations, long timeout, long rowset_size)
+{
+    return impl_->execute(batch_operations, timeout, rowset_size, *this);
+}
+
 void statement::just_execute(long batch_operations, long timeout)
 {
     impl_->just_execute(batch_operations, timeout, *this);
@@ -4525,7 +4747,7 @@ short catalog::primary_keys::column_number() const
 string catalog::primary_keys::primary_key_name() const
 {
     // PK_NAME might be NULL
-    return result_.get<string>(5);
+    return result_.get<string>(5, string());
 }
 
 catalog::procedure_columns::procedure_columns(result& find_result)
@@ -5165,7 +5387,7 @@ short result::column(const string& column_name) const
     return impl_->column(column_name);
 }
 
-string result::column_name(short column) const
+const string& result::column_name(short column) const
 {
     return impl_->column_name(column);
 }
@@ -5220,6 +5442,41 @@ int result::column_c_datatype(const string& column_name) const
     return impl_->column_c_datatype(column_name);
 }
 
+const char* result::column_bound_data(short column) const
+{
+    return impl_->column_bound_data(column);
+}
+
+const null_type* result::column_bound_indicators(short column) const
+{
+    return impl_->column_bound_indicators(column);
+}
+
+unsigned long result::column_bound_length(short column) const
+{
+    return impl_->column_bound_length(column);
+}
+
+long result::rowset_position() const noexcept
+{
+    return impl_->rowset_position();
+}
+
+std::unique_ptr<char[]> result::release_bound_data(short column)
+{
+    return impl_->release_bound_data(column);
+}
+
+bool result::get_data_chunk(
+    short column,
+    void* buffer,
+    std::size_t buffer_size,
+    std::size_t& written,
+    null_type& indicator)
+{
+    return impl_->get_data_chunk(column, buffer, buffer_size, written, indicator);
+}
+
 bool result::next_result()
 {
     return impl_->next_result();
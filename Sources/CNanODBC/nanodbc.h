@@ -564,6 +564,21 @@ public:
         long batch_operations = 1,
         long timeout = 0);
 
+    /// \brief Opens, prepares, and executes the given query directly on the given connection.
+    /// \param conn The connection where the statement will be executed.
+    /// \param query The SQL query that will be executed.
+    /// \param batch_operations Number of batch parameters to process.
+    /// \param timeout The number in seconds before query timeout. 0 means no timeout.
+    /// \param rowset_size Number of rows to fetch per rowset, independent of batch_operations.
+    /// \return A result set object.
+    /// \see execute_direct(class connection&, const string&, long, long)
+    class result execute_direct(
+        class connection& conn,
+        const string& query,
+        long batch_operations,
+        long timeout,
+        long rowset_size);
+
 #if !defined(NANODBC_DISABLE_ASYNC)
     /// \brief Prepare the given statement, in asynchronous mode.
     /// \note If the statement is not open throws programming_error.
@@ -694,6 +709,15 @@ public:
     /// \see open(), prepare(), result, transaction
     class result execute(long batch_operations = 1, long timeout = 0);
 
+    /// \brief Execute the previously prepared query now.
+    /// \param batch_operations Number of batch parameters to process.
+    /// \param timeout The number in seconds before query timeout. 0 means no timeout.
+    /// \param rowset_size Number of rows to fetch per rowset, independent of batch_operations.
+    /// \throws database_error
+    /// \return A result set object.
+    /// \see execute(long, long)
+    class result execute(long batch_operations, long timeout, long rowset_size);
+
     /// \brief Execute the previously prepared query now without constructing result object.
     /// \param batch_operations Rows to fetch per rowset, or number of batch parameters to process.
     /// \param timeout The number in seconds before query timeout. Default 0 meaning no timeout.
@@ -1161,6 +1185,10 @@ public:
     /// \brief Returns the number of transactions currently held for this connection.
     std::size_t transactions() const;
 
+    /// \brief Returns true if a transaction on this connection has been rolled back, so the
+    /// outermost transaction will be rolled back when it ends.
+    bool rollback_pending() const;
+
     /// \brief Returns the native ODBC database connection handle.
     void* native_dbc_handle() const;
 
@@ -1482,8 +1510,9 @@ public:
     ///
     /// Columns are numbered from left to right and 0-indexed.
     /// \param column position.
+    /// \return The name, which stays valid until the result moves to the next result set.
     /// \throws index_range_error
-    string column_name(short column) const;
+    const string& column_name(short column) const;
 
     /// \brief Returns the size of the specified column.
     ///
@@ -1538,6 +1567,58 @@ public:
     /// \brief Returns a identifying integer value representing the C type of this column by name.
     int column_c_datatype(const string& column_name) const;
 
+    /// \brief Returns the buffer bound to the given column for the current rowset.
+    ///
+    /// The buffer holds rowset_size() values of column_bound_length() bytes each, laid out as
+    /// described by column_c_datatype(). It is overwritten by the next fetch.
+    /// \return The bound buffer, or nullptr if the column is not bound (see is_bound()).
+    /// \throws index_range_error
+    const char* column_bound_data(short column) const;
+
+    /// \brief Returns the length/indicator buffer of the given column for the current rowset.
+    ///
+    /// Holds one entry per row of the rowset; SQL_NULL_DATA marks a null value.
+    /// \throws index_range_error
+    const null_type* column_bound_indicators(short column) const;
+
+    /// \brief Returns the size in bytes of a single value in the bound buffer of the given column.
+    /// \throws index_range_error
+    unsigned long column_bound_length(short column) const;
+
+    /// \brief Returns the zero-based position of the current row within the current rowset.
+    long rowset_position() const noexcept;
+
+    /// \brief Transfers ownership of the buffer bound to the given column to the caller.
+    ///
+    /// A newly allocated buffer is bound to the column in its place, so the data of the current
+    /// rowset stays valid in the returned buffer after the next fetch. Values of the current
+    /// rowset can no longer be read through get() once their buffer has been released.
+    /// \return The previously bound buffer, or nullptr if the column is not bound.
+    /// \throws index_range_error, database_error
+    std::unique_ptr<char[]> release_bound_data(short column);
+
+    /// \brief Reads the next part of the value of an unbound (long data) column.
+    ///
+    /// Every call continues where the previous one for the same column and row stopped, so
+    /// values of any size can be read piece by piece without holding all of them in memory.
+    /// The data is read as SQL_C_BINARY: character data arrives in the driver's encoding and
+    /// without a null terminator.
+    /// \param column Zero-based index of the column.
+    /// \param buffer Receives up to buffer_size bytes.
+    /// \param buffer_size The size of buffer in bytes.
+    /// \param written Set to the amount of bytes written to buffer.
+    /// \param indicator Set to SQL_NULL_DATA if the value is null, SQL_NO_TOTAL if the driver does
+    ///        not know how much data is left, and to the amount of bytes left before this call
+    ///        otherwise. Left untouched once the whole value has been read.
+    /// \return false if nothing is left to read after this call.
+    /// \throws index_range_error, programming_error if the column is bound, database_error
+    bool get_data_chunk(
+        short column,
+        void* buffer,
+        std::size_t buffer_size,
+        std::size_t& written,
+        null_type& indicator);
+
     /// \brief Returns the next result, e.g. when stored procedure returns multiple result sets.
     bool next_result();
 
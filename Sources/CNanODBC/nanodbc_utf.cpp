@@ -0,0 +1,424 @@
+/// \file nanodbc_utf.cpp UTF-8 <-> UTF-16 transcoding.
+///
+/// Text returned by databases is overwhelmingly ASCII, so both directions copy runs of ASCII
+/// characters in blocks: 32 at a time with AVX2, 16 with SSE2, and 8 or 4 with plain 64-bit
+/// integer operations everywhere else. Anything that is not ASCII is transcoded one code point
+/// at a time. AVX2 is only used if the running CPU supports it.
+
+#include "nanodbc_utf.h"
+
+#include <codecvt>
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NANODBC_UTF_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define NANODBC_UTF_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+namespace nanodbc
+{
+namespace utf
+{
+namespace
+{
+
+// MARK: Code point at a time -
+
+// Transcodes the code point starting at `in[i]`, which is not ASCII, to UTF-8.
+// Returns the amount of code units consumed, or 0 if `in[i]` is an unpaired surrogate.
+inline std::size_t encode_one(char16_t const* in, std::size_t i, std::size_t n, char*& out)
+{
+    std::uint32_t const c = in[i];
+
+    if (c < 0x800)
+    {
+        *out++ = static_cast<char>(0xC0 | (c >> 6));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+        return 1;
+    }
+
+    if (c < 0xD800 || c > 0xDFFF)
+    {
+        *out++ = static_cast<char>(0xE0 | (c >> 12));
+        *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+        return 1;
+    }
+
+    if (c > 0xDBFF || i + 1 == n || in[i + 1] < 0xDC00 || in[i + 1] > 0xDFFF)
+        return 0;
+
+    std::uint32_t const cp = 0x10000 + ((c - 0xD800) << 10) + (in[i + 1] - 0xDC00);
+    *out++ = static_cast<char>(0xF0 | (cp >> 18));
+    *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+}
+
+inline bool is_continuation(unsigned char b)
+{
+    return (b & 0xC0) == 0x80;
+}
+
+// Transcodes the code point starting at `in[i]`, which is not ASCII, to UTF-16.
+// Returns the amount of bytes consumed, or 0 if the input is malformed, overlong or encodes a
+// surrogate or a value above U+10FFFF.
+inline std::size_t decode_one(char const* in, std::size_t i, std::size_t n, char16_t*& out)
+{
+    auto const s = reinterpret_cast<unsigned char const*>(in) + i;
+    std::size_t const left = n - i;
+    unsigned char const c = s[0];
+
+    if (c < 0xC2)
+        return 0;
+
+    if (c < 0xE0)
+    {
+        if (left < 2 || !is_continuation(s[1]))
+            return 0;
+        *out++ = static_cast<char16_t>(((c & 0x1F) << 6) | (s[1] & 0x3F));
+        return 2;
+    }
+
+    if (c < 0xF0)
+    {
+        if (left < 3 || !is_continuation(s[1]) || !is_continuation(s[2]))
+            return 0;
+        if ((c == 0xE0 && s[1] < 0xA0) || (c == 0xED && s[1] > 0x9F))
+            return 0;
+        *out++ = static_cast<char16_t>(((c & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+        return 3;
+    }
+
+    if (c < 0xF5)
+    {
+        if (left < 4 || !is_continuation(s[1]) || !is_continuation(s[2]) ||
+            !is_continuation(s[3]))
+            return 0;
+        if ((c == 0xF0 && s[1] < 0x90) || (c == 0xF4 && s[1] > 0x8F))
+            return 0;
+        std::uint32_t const cp = ((c & 0x07) << 18) | ((s[1] & 0x3F) << 12) |
+                                 ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        *out++ = static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+        *out++ = static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+        return 4;
+    }
+
+    return 0;
+}
+
+// MARK: ASCII blocks -
+//
+// Each of these copies ASCII characters from the start of `in` to `out` for as long as whole
+// blocks of them are ASCII, and returns the amount copied.
+
+struct portable_ascii
+{
+    static std::size_t utf16(char16_t const* in, std::size_t n, char* out)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            std::uint64_t units;
+            std::memcpy(&units, in + i, sizeof(units));
+            if (units & 0xFF80FF80FF80FF80ull)
+                break;
+            for (std::size_t k = 0; k < 4; ++k)
+                out[i + k] = static_cast<char>(in[i + k]);
+        }
+        return i;
+    }
+
+    static std::size_t utf8(char const* in, std::size_t n, char16_t* out)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            std::uint64_t bytes;
+            std::memcpy(&bytes, in + i, sizeof(bytes));
+            if (bytes & 0x8080808080808080ull)
+                break;
+            for (std::size_t k = 0; k < 8; ++k)
+                out[i + k] = static_cast<char16_t>(in[i + k]);
+        }
+        return i;
+    }
+};
+
+#ifdef NANODBC_UTF_SSE2
+struct sse2_ascii
+{
+    static std::size_t utf16(char16_t const* in, std::size_t n, char* out)
+    {
+        __m128i const non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+            __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i + 8));
+            __m128i const high = _mm_and_si128(_mm_or_si128(a, b), non_ascii);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+        }
+        return i + portable_ascii::utf16(in + i, n - i, out + i);
+    }
+
+    static std::size_t utf8(char const* in, std::size_t n, char16_t* out)
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+            if (_mm_movemask_epi8(v) != 0)
+                break;
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(out + i + 8),
+                _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+        }
+        return i + portable_ascii::utf8(in + i, n - i, out + i);
+    }
+};
+#endif
+
+#ifdef NANODBC_UTF_AVX2
+struct avx2_ascii
+{
+    __attribute__((target("avx2"))) static std::size_t
+    utf16(char16_t const* in, std::size_t n, char* out)
+    {
+        __m256i const non_ascii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+            __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i + 16));
+            if (!_mm256_testz_si256(_mm256_or_si256(a, b), non_ascii))
+                break;
+            // Packing works per 128-bit lane, so restore the order of the 64-bit quarters.
+            __m256i const packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+        }
+        return i + sse2_ascii::utf16(in + i, n - i, out + i);
+    }
+
+    __attribute__((target("avx2"))) static std::size_t
+    utf8(char const* in, std::size_t n, char16_t* out)
+    {
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+            if (_mm256_movemask_epi8(v) != 0)
+                break;
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(out + i),
+                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(out + i + 16),
+                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+        }
+        return i + sse2_ascii::utf8(in + i, n - i, out + i);
+    }
+};
+#endif
+
+// MARK: Transcoding loops -
+
+template <class Ascii>
+std::size_t transcode_utf16(char16_t const* in, std::size_t n, char* out) noexcept
+{
+    char* const begin = out;
+    std::size_t i = 0;
+    while (i < n)
+    {
+        std::size_t const ascii = Ascii::utf16(in + i, n - i, out);
+        i += ascii;
+        out += ascii;
+
+        // Finish a run of ASCII shorter than a block before trying the next block.
+        for (; i < n && in[i] < 0x80; ++i)
+            *out++ = static_cast<char>(in[i]);
+        if (i == n)
+            break;
+
+        std::size_t const consumed = encode_one(in, i, n, out);
+        if (consumed == 0)
+            return npos;
+        i += consumed;
+    }
+    return static_cast<std::size_t>(out - begin);
+}
+
+template <class Ascii>
+std::size_t transcode_utf8(char const* in, std::size_t n, char16_t* out) noexcept
+{
+    char16_t* const begin = out;
+    std::size_t i = 0;
+    while (i < n)
+    {
+        std::size_t const ascii = Ascii::utf8(in + i, n - i, out);
+        i += ascii;
+        out += ascii;
+
+        for (; i < n && static_cast<unsigned char>(in[i]) < 0x80; ++i)
+            *out++ = static_cast<char16_t>(in[i]);
+        if (i == n)
+            break;
+
+        std::size_t const consumed = decode_one(in, i, n, out);
+        if (consumed == 0)
+            return npos;
+        i += consumed;
+    }
+    return static_cast<std::size_t>(out - begin);
+}
+
+#ifdef NANODBC_UTF_AVX2
+// The loops are compiled for AVX2 as a whole so that the AVX2 blocks can be inlined into them.
+__attribute__((target("avx2"))) std::size_t
+transcode_utf16_avx2(char16_t const* in, std::size_t n, char* out) noexcept
+{
+    return transcode_utf16<avx2_ascii>(in, n, out);
+}
+
+__attribute__((target("avx2"))) std::size_t
+transcode_utf8_avx2(char const* in, std::size_t n, char16_t* out) noexcept
+{
+    return transcode_utf8<avx2_ascii>(in, n, out);
+}
+
+bool has_avx2()
+{
+    static bool const supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+typedef std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> codecvt_converter;
+
+codecvt_converter& converter()
+{
+    static thread_local codecvt_converter converter;
+    return converter;
+}
+
+// `std::codecvt_utf8_utf16` accepts surrogates encoded in UTF-8 (0xED followed by 0xA0-0xBF),
+// which the other implementations reject as invalid UTF-8.
+bool encodes_surrogate(char const* in, std::size_t n)
+{
+    for (std::size_t i = 0; i + 1 < n; ++i)
+    {
+        if (static_cast<unsigned char>(in[i]) == 0xED &&
+            static_cast<unsigned char>(in[i + 1]) >= 0xA0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// MARK: Public interface -
+
+std::size_t
+utf16_to_utf8(char16_t const* in, std::size_t n, char* out, implementation impl) noexcept
+{
+    switch (impl)
+    {
+    case implementation::best:
+#ifdef NANODBC_UTF_AVX2
+        if (has_avx2())
+            return transcode_utf16_avx2(in, n, out);
+#endif
+#ifdef NANODBC_UTF_SSE2
+        return transcode_utf16<sse2_ascii>(in, n, out);
+#else
+        return transcode_utf16<portable_ascii>(in, n, out);
+#endif
+    case implementation::scalar:
+        return transcode_utf16<portable_ascii>(in, n, out);
+    case implementation::codecvt:
+        try
+        {
+            auto const s = converter().to_bytes(in, in + n);
+            // A surrogate at the end of the input is left unconverted instead of throwing.
+            if (converter().converted() != n)
+                return npos;
+            std::memcpy(out, s.data(), s.size());
+            return s.size();
+        }
+        catch (std::range_error const&)
+        {
+            return npos;
+        }
+    }
+    return npos;
+}
+
+std::size_t
+utf8_to_utf16(char const* in, std::size_t n, char16_t* out, implementation impl) noexcept
+{
+    switch (impl)
+    {
+    case implementation::best:
+#ifdef NANODBC_UTF_AVX2
+        if (has_avx2())
+            return transcode_utf8_avx2(in, n, out);
+#endif
+#ifdef NANODBC_UTF_SSE2
+        return transcode_utf8<sse2_ascii>(in, n, out);
+#else
+        return transcode_utf8<portable_ascii>(in, n, out);
+#endif
+    case implementation::scalar:
+        return transcode_utf8<portable_ascii>(in, n, out);
+    case implementation::codecvt:
+        try
+        {
+            if (encodes_surrogate(in, n))
+                return npos;
+            auto const s = converter().from_bytes(in, in + n);
+            // A truncated sequence at the end of the input is left unconverted instead of throwing.
+            if (converter().converted() != n)
+                return npos;
+            std::memcpy(out, s.data(), s.size() * sizeof(char16_t));
+            return s.size();
+        }
+        catch (std::range_error const&)
+        {
+            return npos;
+        }
+    }
+    return npos;
+}
+
+void utf16_to_utf8(char16_t const* in, std::size_t n, std::string& out)
+{
+    out.resize(3 * n);
+    std::size_t const written = utf16_to_utf8(in, n, &out[0]);
+    if (written == npos)
+        throw std::range_error("utf16_to_utf8: unpaired surrogate");
+    out.resize(written);
+}
+
+void utf8_to_utf16(char const* in, std::size_t n, std::u16string& out)
+{
+    out.resize(n);
+    std::size_t const written = utf8_to_utf16(in, n, &out[0]);
+    if (written == npos)
+        throw std::range_error("utf8_to_utf16: invalid UTF-8");
+    out.resize(written);
+}
+
+} // namespace utf
+} // namespace nanodbc
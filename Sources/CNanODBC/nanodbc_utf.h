@@ -0,0 +1,56 @@
+/// \file nanodbc_utf.h UTF-8 <-> UTF-16 transcoding used by nanodbc's string conversions.
+#ifndef NANODBC_UTF_H
+#define NANODBC_UTF_H
+
+#include <cstddef>
+#include <string>
+
+namespace nanodbc
+{
+namespace utf
+{
+
+/// \brief Selects the code path used by the transcoding functions.
+enum class implementation
+{
+    best,   ///< The fastest implementation supported by the running CPU.
+    scalar, ///< The portable implementation, without SIMD instructions.
+    codecvt ///< `std::wstring_convert`, the converter nanodbc used before; for benchmarks.
+};
+
+/// \brief Returned by the transcoding functions if the input is not well-formed.
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+/// \brief Transcodes `n` UTF-16 code units to UTF-8.
+///
+/// `out` must have room for `3 * n` bytes.
+/// \return The amount of bytes written to `out`, or `npos` if the input contains an unpaired
+///         surrogate.
+std::size_t utf16_to_utf8(
+    char16_t const* in,
+    std::size_t n,
+    char* out,
+    implementation impl = implementation::best) noexcept;
+
+/// \brief Transcodes `n` bytes of UTF-8 to UTF-16.
+///
+/// `out` must have room for `n` code units.
+/// \return The amount of code units written to `out`, or `npos` if the input is not valid UTF-8.
+std::size_t utf8_to_utf16(
+    char const* in,
+    std::size_t n,
+    char16_t* out,
+    implementation impl = implementation::best) noexcept;
+
+/// \brief Replaces the contents of `out` with `n` UTF-16 code units transcoded to UTF-8.
+/// \throws std::range_error if the input contains an unpaired surrogate.
+void utf16_to_utf8(char16_t const* in, std::size_t n, std::string& out);
+
+/// \brief Replaces the contents of `out` with `n` bytes of UTF-8 transcoded to UTF-16.
+/// \throws std::range_error if the input is not valid UTF-8.
+void utf8_to_utf16(char const* in, std::size_t n, std::u16string& out);
+
+} // namespace utf
+} // namespace nanodbc
+
+#endif // NANODBC_UTF_H
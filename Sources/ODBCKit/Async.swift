@@ -0,0 +1,121 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+/// Hands the continuation of a call that runs on one of CNanODBC's I/O threads to its C completion.
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+final class IOCompletion<T> {
+	let continuation: CheckedContinuation<T, Error>
+
+	private init(_ continuation: CheckedContinuation<T, Error>) {
+		self.continuation = continuation
+	}
+
+	/// Suspends until the completion passed to `start` has been called with the context passed along with it.
+	static func run(_ start: (UnsafeMutableRawPointer) -> Void) async throws -> T {
+		try await withCheckedThrowingContinuation { continuation in
+			start(Unmanaged.passRetained(IOCompletion(continuation)).toOpaque())
+		}
+	}
+
+	static func resume(_ context: UnsafeMutableRawPointer?, with result: Swift.Result<T, Error>) {
+		Unmanaged<IOCompletion<T>>.fromOpaque(context!).takeRetainedValue().continuation.resume(with: result)
+	}
+}
+
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+enum IOCompletions {
+	static let result: CResultCompletion = { context, result, error in
+		if let error = error {
+			IOCompletion<OpaquePointer>.resume(context, with: .failure(ODBCError.fromErrorPointer(error)))
+		} else if let result = result {
+			IOCompletion<OpaquePointer>.resume(context, with: .success(result))
+		} else {
+			IOCompletion<OpaquePointer>.resume(
+				context,
+				with: .failure(ODBCError.unexpectedNull(name: "nanodbc::statement::execute"))
+			)
+		}
+	}
+
+	static let bool: CBoolCompletion = { context, value, error in
+		if let error = error {
+			IOCompletion<Bool>.resume(context, with: .failure(ODBCError.fromErrorPointer(error)))
+		} else {
+			IOCompletion<Bool>.resume(context, with: .success(value))
+		}
+	}
+}
+
+// The `async` variants are named apart from the blocking ones, as an `async` overload with the same name would be
+// picked over them in every asynchronous context.
+
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+public extension Connection {
+	/// Executes `query` on the database like ``justExecute(query:timeout:)``, suspending instead of blocking the
+	/// calling thread while the query runs.
+	/// - Throws: `ODBCError`.
+	func justExecuteAsync(query: String, timeout: Int = 0) async throws {
+		_ = try await IOCompletion<Bool>.run { context in
+			CNanODBC.justExecuteAsync(self.connection, query, 1, timeout, context, IOCompletions.bool)
+		}
+	}
+
+	/// Executes `query` on the database like ``execute(query:rowsetSize:timeout:)``, suspending instead of blocking
+	/// the calling thread while the query runs.
+	///
+	/// The query runs on a thread of its own, so it does not hold up Swift's cooperative thread pool, however long
+	/// the database takes to answer.
+	///
+	/// - Throws: `ODBCError`.
+	func executeAsync(query: String, rowsetSize: Int = 1, timeout: Int = 0) async throws -> Result {
+		let res = try await IOCompletion<OpaquePointer>.run { context in
+			cExecuteAsync(self.connection, query, 1, rowsetSize, timeout, context, IOCompletions.result)
+		}
+
+		return Result(resPointer: res, owner: self)
+	}
+}
+
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+public extension Statement {
+	/// Executes this `Statement` like ``execute(with:rowsetSize:timeout:)``, suspending instead of blocking the
+	/// calling thread while it runs.
+	/// - Throws: `ODBCError`.
+	func executeAsync<B: BindableValue>(
+		with values: [B?] = [],
+		rowsetSize: Int = 1,
+		timeout: Int = 0
+	) async throws -> Result {
+		for i in 0..<values.count {
+			try values[i].bind(stmtPointer: self.statementPointer, index: Int16(i))
+		}
+
+		let res = try await IOCompletion<OpaquePointer>.run { context in
+			stmtExecuteAsync(self.statementPointer, rowsetSize, timeout, context, IOCompletions.result)
+		}
+
+		return Result(resPointer: res, owner: self)
+	}
+}
+
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+public extension Result {
+	/// Advances to the next row like ``next()``, suspending instead of blocking the calling thread while the next
+	/// rowset is fetched.
+	///
+	/// Rows of a rowset that has already been fetched are read from memory; only moving past the end of the rowset
+	/// waits for the driver.
+	///
+	/// - Throws: `ODBCError`.
+	/// - Returns: `true` if `nextAsync` successfully advanced to the next row, `false` otherwise.
+	func nextAsync() async throws -> Bool {
+		try await IOCompletion<Bool>.run { context in
+			resultNextAsync(self.resPointer, context, IOCompletions.bool)
+		}
+	}
+}
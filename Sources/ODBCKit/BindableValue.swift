@@ -20,7 +20,8 @@ public enum ODBCValueType {
 	     date,
 	     time,
 	     timestamp,
-	     bytes
+	     bytes,
+	     decimal
 }
 
 /// A value that can be bound to a parameter in a SQL query.
@@ -152,6 +153,17 @@ extension ODBCTimeStamp: BindableValue {
 	}
 }
 
+extension ODBCDecimal: BindableValue {
+	public var type: ODBCValueType { .decimal }
+
+	/// Binds the decimal as text, which drivers convert to `DECIMAL`/`NUMERIC` without losing digits.
+	public func bind(stmtPointer: OpaquePointer, index: Int16) throws {
+		if let errorPointer = stmtBindString(stmtPointer, index, self.description) {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+	}
+}
+
 extension Array: BindableValue where Element == UInt8 {
 	public var type: ODBCValueType { .bytes }
 
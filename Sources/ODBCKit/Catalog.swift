@@ -6,11 +6,23 @@
 
 import CNanODBC
 
-public struct Catalog {
-	private var catalogPointer: OpaquePointer
+/// Describes the catalogs, schemas and tables of a database.
+///
+/// Lookups are answered from the connection's metadata cache while it is on, see
+/// ``Connection/metadataCacheTTL``.
+public final class Catalog {
+	private let catalogPointer: OpaquePointer
+
+	/// Kept so that the connection outlives this catalog.
+	public let connection: Connection
 
 	public init(connection: Connection) {
 		self.catalogPointer = catalogCreate(connection.connection)
+		self.connection = connection
+	}
+
+	deinit {
+		catalogDestroy(self.catalogPointer)
 	}
 
 	public var schemas: [String] {
@@ -18,12 +30,12 @@ public struct Catalog {
 			var size: UInt = 0
 			let errorPointer = UnsafeMutablePointer.cErrorPointer
 
-			guard let cSchemas = catalogListSchemas(self.catalogPointer, &size, errorPointer) else { return [] }
-
-			if errorPointer.pointee.isValid {
+			guard let cSchemas = catalogListSchemas(self.catalogPointer, &size, errorPointer) else {
 				throw ODBCError.fromErrorPointer(errorPointer)
 			}
 
+			defer { catalogListDestroy(cSchemas) }
+
 			return UnsafeBufferPointer(start: cSchemas, count: Int(size))
 				.map(\.string)
 		}
@@ -34,14 +46,335 @@ public struct Catalog {
 			var size: UInt = 0
 			let errorPointer = UnsafeMutablePointer.cErrorPointer
 
-			guard let cCatalogs = catalogListCatalogs(self.catalogPointer, &size, errorPointer) else { return [] }
-
-			if errorPointer.pointee.isValid {
+			guard let cCatalogs = catalogListCatalogs(self.catalogPointer, &size, errorPointer) else {
 				throw ODBCError.fromErrorPointer(errorPointer)
 			}
 
+			defer { catalogListDestroy(cCatalogs) }
+
 			return UnsafeBufferPointer(start: cCatalogs, count: Int(size))
 				.map(\.string)
 		}
 	}
+
+	/// The tables matching `table`, `schema` and `catalog` whose type is one of `types`.
+	///
+	/// `table`, `schema` and `catalog` are search patterns, in which `%` matches any amount of characters and `_` any
+	/// single one. An empty pattern matches everything.
+	///
+	/// - Parameter types: A comma-separated list of table types such as `"TABLE,VIEW"`. An empty string matches every
+	///   type.
+	/// - Throws: ``ODBCError``.
+	public func tables(
+		table: String = "",
+		types: String = "",
+		schema: String = "",
+		catalog: String = ""
+	) throws -> [CatalogTable] {
+		try self.rows(
+			find: { catalogFindTables(self.catalogPointer, table, types, schema, catalog, $0) },
+			array: catalogTablesArray,
+			destroy: catalogTablesDestroy,
+			CatalogTable.init
+		)
+	}
+
+	/// The columns of the tables matching `table`, `schema` and `catalog` whose names match `column`, searched for
+	/// like ``tables(table:types:schema:catalog:)``.
+	///
+	/// - Throws: ``ODBCError``.
+	public func columns(
+		table: String,
+		schema: String = "",
+		catalog: String = "",
+		column: String = ""
+	) throws -> [CatalogColumn] {
+		try self.rows(
+			find: { catalogFindColumns(self.catalogPointer, column, table, schema, catalog, $0) },
+			array: catalogColumnsArray,
+			destroy: catalogColumnsDestroy,
+			CatalogColumn.init
+		)
+	}
+
+	/// The columns that make up the primary key of `table`, in the order of the key.
+	/// - Throws: ``ODBCError``.
+	public func primaryKeys(table: String, schema: String = "", catalog: String = "") throws -> [CatalogPrimaryKey] {
+		try self.rows(
+			find: { catalogFindPrimaryKeys(self.catalogPointer, table, schema, catalog, $0) },
+			array: catalogPrimaryKeysArray,
+			destroy: catalogPrimaryKeysDestroy,
+			CatalogPrimaryKey.init
+		)
+	}
+
+	/// The privileges granted on the tables matching `table` and `schema`, searched for like
+	/// ``tables(table:types:schema:catalog:)``. `catalog` is not a search pattern.
+	/// - Throws: ``ODBCError``.
+	public func tablePrivileges(
+		table: String = "",
+		schema: String = "",
+		catalog: String = ""
+	) throws -> [CatalogTablePrivilege] {
+		try self.rows(
+			find: { catalogFindTablePrivileges(self.catalogPointer, table, schema, catalog, $0) },
+			array: catalogTablePrivilegesArray,
+			destroy: catalogTablePrivilegesDestroy,
+			CatalogTablePrivilege.init
+		)
+	}
+
+	/// The procedures and functions matching `procedure`, `schema` and `catalog`, searched for like
+	/// ``tables(table:types:schema:catalog:)``.
+	/// - Throws: ``ODBCError``.
+	public func procedures(
+		procedure: String = "",
+		schema: String = "",
+		catalog: String = ""
+	) throws -> [CatalogProcedure] {
+		try self.rows(
+			find: { catalogFindProcedures(self.catalogPointer, procedure, schema, catalog, $0) },
+			array: catalogProceduresArray,
+			destroy: catalogProceduresDestroy,
+			CatalogProcedure.init
+		)
+	}
+
+	/// The parameters and result columns of the procedures matching `procedure`, `schema` and `catalog` whose names
+	/// match `column`, searched for like ``tables(table:types:schema:catalog:)``.
+	/// - Throws: ``ODBCError``.
+	public func procedureColumns(
+		procedure: String,
+		schema: String = "",
+		catalog: String = "",
+		column: String = ""
+	) throws -> [CatalogProcedureColumn] {
+		try self.rows(
+			find: { catalogFindProcedureColumns(self.catalogPointer, column, procedure, schema, catalog, $0) },
+			array: catalogProcedureColumnsArray,
+			destroy: catalogProcedureColumnsDestroy,
+			CatalogProcedureColumn.init
+		)
+	}
+
+	/// Runs a lookup and converts all of its rows, which the C side returns as one contiguous array.
+	private func rows<Row, T>(
+		find: (UnsafeMutablePointer<CError>) -> OpaquePointer?,
+		array: (OpaquePointer, UnsafeMutablePointer<UInt>) -> UnsafePointer<Row>?,
+		destroy: (OpaquePointer) -> Void,
+		_ transform: (Row) -> T
+	) throws -> [T] {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		guard let found = find(errorPointer) else { throw ODBCError.fromErrorPointer(errorPointer) }
+
+		defer { destroy(found) }
+
+		var count: UInt = 0
+		let rows = array(found, &count)
+
+		return UnsafeBufferPointer(start: rows, count: Int(count)).map(transform)
+	}
+}
+
+/// A table, view or other kind of table of a database.
+public struct CatalogTable {
+	public let tableCatalog: String
+	public let tableSchema: String
+	public let tableName: String
+	/// `"TABLE"`, `"VIEW"`, `"SYSTEM TABLE"` or another type specific to the database.
+	public let tableType: String
+	public let remarks: String
+
+	init(_ table: CCatalogTable) {
+		self.tableCatalog = table.tableCatalog.string
+		self.tableSchema = table.tableSchema.string
+		self.tableName = table.tableName.string
+		self.tableType = table.tableType.string
+		self.remarks = table.remarks.string
+	}
+}
+
+/// A column that is part of the primary key of a table.
+public struct CatalogPrimaryKey {
+	public let tableCatalog: String
+	public let tableSchema: String
+	public let tableName: String
+	public let columnName: String
+	/// The 1-based position of the column in the key.
+	public let columnNumber: Int16
+	/// The name of the key, or an empty string if it has none.
+	public let primaryKeyName: String
+
+	init(_ key: CCatalogPrimaryKey) {
+		self.tableCatalog = key.tableCatalog.string
+		self.tableSchema = key.tableSchema.string
+		self.tableName = key.tableName.string
+		self.columnName = key.columnName.string
+		self.columnNumber = key.columnNumber
+		self.primaryKeyName = key.primaryKeyName.string
+	}
+}
+
+/// A privilege granted on a table.
+public struct CatalogTablePrivilege {
+	public let tableCatalog: String
+	public let tableSchema: String
+	public let tableName: String
+	/// Who granted the privilege, or an empty string if unknown.
+	public let grantor: String
+	public let grantee: String
+	/// `"SELECT"`, `"INSERT"`, `"UPDATE"`, `"DELETE"`, `"REFERENCES"` or another privilege specific to the database.
+	public let privilege: String
+	/// If the grantee may grant the privilege to others, or `nil` if unknown.
+	public let isGrantable: Bool?
+
+	init(_ privilege: CCatalogTablePrivilege) {
+		self.tableCatalog = privilege.tableCatalog.string
+		self.tableSchema = privilege.tableSchema.string
+		self.tableName = privilege.tableName.string
+		self.grantor = privilege.grantor.string
+		self.grantee = privilege.grantee.string
+		self.privilege = privilege.privilege.string
+
+		switch privilege.isGrantable.string {
+			case "YES": self.isGrantable = true
+			case "NO": self.isGrantable = false
+			default: self.isGrantable = nil
+		}
+	}
+}
+
+/// A stored procedure or function.
+public struct CatalogProcedure {
+	public enum Kind {
+		case procedure
+		case function
+		case unknown
+	}
+
+	public let procedureCatalog: String
+	public let procedureSchema: String
+	public let procedureName: String
+	public let remarks: String
+	/// If the procedure returns a value.
+	public let kind: Kind
+
+	init(_ procedure: CCatalogProcedure) {
+		self.procedureCatalog = procedure.procedureCatalog.string
+		self.procedureSchema = procedure.procedureSchema.string
+		self.procedureName = procedure.procedureName.string
+		self.remarks = procedure.remarks.string
+
+		// `SQL_PT_PROCEDURE` and `SQL_PT_FUNCTION`.
+		switch procedure.procedureType {
+			case 1: self.kind = .procedure
+			case 2: self.kind = .function
+			default: self.kind = .unknown
+		}
+	}
+}
+
+/// A parameter or result column of a stored procedure.
+public struct CatalogProcedureColumn {
+	public enum Kind {
+		case input
+		case inputOutput
+		case output
+		case returnValue
+		case resultColumn
+		case unknown
+	}
+
+	public let procedureCatalog: String
+	public let procedureSchema: String
+	public let procedureName: String
+	public let columnName: String
+	public let kind: Kind
+	/// The name the database gives the column's type.
+	public let typeName: String
+	/// The SQL type of the column, or `nil` if it is specific to the driver.
+	public let dataType: ODBCDataType?
+	public let columnSize: Int
+	public let decimalDigits: Int16
+	/// If the column can hold `null`, or `nil` if the driver does not know.
+	public let isNullable: Bool?
+	/// The column's default value as SQL, or an empty string if it has none.
+	public let defaultValue: String
+	public let remarks: String
+	/// The 1-based position of a parameter, or 0 for the return value.
+	public let ordinalPosition: Int
+
+	init(_ column: CCatalogProcedureColumn) {
+		self.procedureCatalog = column.procedureCatalog.string
+		self.procedureSchema = column.procedureSchema.string
+		self.procedureName = column.procedureName.string
+		self.columnName = column.columnName.string
+		self.typeName = column.typeName.string
+		self.dataType = ODBCDataType(rawValue: Int32(column.dataType))
+		self.columnSize = column.columnSize
+		self.decimalDigits = column.decimalDigits
+		self.defaultValue = column.defaultValue.string
+		self.remarks = column.remarks.string
+		self.ordinalPosition = column.ordinalPosition
+
+		// `SQL_PARAM_INPUT`, `SQL_PARAM_INPUT_OUTPUT`, `SQL_RESULT_COL`, `SQL_PARAM_OUTPUT` and `SQL_RETURN_VALUE`.
+		switch column.columnType {
+			case 1: self.kind = .input
+			case 2: self.kind = .inputOutput
+			case 3: self.kind = .resultColumn
+			case 4: self.kind = .output
+			case 5: self.kind = .returnValue
+			default: self.kind = .unknown
+		}
+
+		// `SQL_NO_NULLS`, `SQL_NULLABLE` and `SQL_NULLABLE_UNKNOWN`.
+		switch column.nullable {
+			case 0: self.isNullable = false
+			case 1: self.isNullable = true
+			default: self.isNullable = nil
+		}
+	}
+}
+
+/// A column of a table, as described by the driver.
+public struct CatalogColumn {
+	public let tableCatalog: String
+	public let tableSchema: String
+	public let tableName: String
+	public let name: String
+	/// The name the database gives the column's type.
+	public let typeName: String
+	/// The SQL type of the column, or `nil` if it is specific to the driver.
+	public let dataType: ODBCDataType?
+	public let columnSize: Int
+	public let decimalDigits: Int16
+	/// If the column can hold `null`, or `nil` if the driver does not know.
+	public let isNullable: Bool?
+	/// The column's default value as SQL, or an empty string if it has none.
+	public let defaultValue: String
+	public let remarks: String
+	/// The 1-based position of the column in its table.
+	public let ordinalPosition: Int
+
+	init(_ column: CCatalogColumn) {
+		self.tableCatalog = column.tableCatalog.string
+		self.tableSchema = column.tableSchema.string
+		self.tableName = column.tableName.string
+		self.name = column.name.string
+		self.typeName = column.typeName.string
+		self.dataType = ODBCDataType(rawValue: Int32(column.dataType))
+		self.columnSize = column.columnSize
+		self.decimalDigits = column.decimalDigits
+		self.defaultValue = column.defaultValue.string
+		self.remarks = column.remarks.string
+		self.ordinalPosition = column.ordinalPosition
+
+		// `SQL_NO_NULLS`, `SQL_NULLABLE` and `SQL_NULLABLE_UNKNOWN`.
+		switch column.nullable {
+			case 0: self.isNullable = false
+			case 1: self.isNullable = true
+			default: self.isNullable = nil
+		}
+	}
 }
@@ -0,0 +1,152 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Connection {
+	/// The outcome of ``Connection/bulkInsert(table:columns:rows:batchSize:byteBudget:timeout:)``.
+	struct BulkInsertReport {
+		/// The amount of rows that have been inserted.
+		public let insertedRows: Int
+
+		/// The amount of batches that have been executed and committed.
+		public let batches: Int
+
+		/// The positions in the inserted sequence of rows the driver reported as failed while the rest of their batch
+		/// was inserted.
+		public let failedRows: [Int]
+	}
+
+	/// Inserts `rows` into `table`, executing the insert once for many rows at a time and committing every batch.
+	///
+	/// ```swift
+	/// let report = try conn.bulkInsert(
+	/// 	table: "measurements",
+	/// 	columns: ["sensor", "value"],
+	/// 	rows: readings.lazy.map { [$0.sensor, $0.value] }
+	/// )
+	/// ```
+	///
+	/// `rows` is consumed as it is inserted, so it can be produced lazily. A batch is executed once it holds
+	/// `batchSize` rows, or once its parameter buffers take up about `byteBudget` bytes, whichever comes first. Every
+	/// row is bound column by column, so the values of a column must have the same types as for
+	/// ``Statement/executeBatch(rows:timeout:)``.
+	///
+	/// Each batch is committed in a transaction of its own; if a batch fails, it is rolled back and the error is
+	/// thrown, leaving the batches before it inserted. Within an enclosing transaction, the batches are only
+	/// committed along with it.
+	///
+	/// - Parameters:
+	///   - table: The name of the table. It is quoted, so pass it as it is named in the database.
+	///   - columns: The names of the columns that the values of each row are inserted into, quoted like `table`.
+	///   - rows: The rows to insert, with one value per column.
+	///   - batchSize: The maximum amount of rows in a batch.
+	///   - byteBudget: The amount of bytes the parameter buffers of a batch may take up.
+	///   - timeout: The amount of seconds to wait for each batch to execute. 0 means no timeout.
+	/// - Throws: ``ODBCError``.
+	@discardableResult
+	func bulkInsert<S: Sequence>(
+		table: String,
+		columns: [String],
+		rows: S,
+		batchSize: Int = 1000,
+		byteBudget: Int = 4 << 20,
+		timeout: Int = 0
+	) throws -> BulkInsertReport where S.Element == [BindableValue?] {
+		guard !columns.isEmpty else {
+			throw ODBCError.programmingError(message: "bulkInsert requires at least one column")
+		}
+
+		let query = "INSERT INTO \(Self.quote(table)) (\(columns.map(Self.quote).joined(separator: ", "))) "
+			+ "VALUES (\(Array(repeating: "?", count: columns.count).joined(separator: ", ")));"
+		let stmt = Statement(connection: self, query: query, timeout: timeout)
+
+		var batch: [[BindableValue?]] = []
+		batch.reserveCapacity(max(batchSize, 1))
+		var statuses: [ParameterRowStatus] = []
+
+		// nanodbc gives every value of a column as much room as the widest one, plus a length/null indicator.
+		var widths = [Int](repeating: 0, count: columns.count)
+		var rowWidth = 0
+
+		var firstRow = 0
+		var insertedRows = 0
+		var batches = 0
+		var failedRows: [Int] = []
+
+		func execute() throws {
+			if statuses.count < batch.count {
+				statuses = Array(repeating: .unknownRow, count: batch.count)
+			}
+
+			try self.withTransaction { _ in
+				_ = try statuses.withUnsafeMutableBufferPointer { statuses in
+					try stmt.executeBatch(rows: batch, timeout: timeout, statuses: statuses.baseAddress)
+				}
+			}
+
+			for (i, status) in statuses[..<batch.count].enumerated() {
+				switch status {
+					case .failedRow: failedRows.append(firstRow + i)
+					case .unusedRow: break
+					// Drivers that cannot report the outcome of single rows only succeed if all of them did.
+					default: insertedRows += 1
+				}
+			}
+
+			batches += 1
+			firstRow += batch.count
+			batch.removeAll(keepingCapacity: true)
+			widths = widths.map { _ in 0 }
+			rowWidth = 0
+		}
+
+		for row in rows {
+			guard row.count == columns.count else {
+				let position = firstRow + batch.count
+
+				throw ODBCError.programmingError(
+					message: "bulkInsert expected \(columns.count) values in row \(position), got \(row.count)"
+				)
+			}
+
+			for (column, value) in row.enumerated() {
+				let width = Self.width(of: value)
+
+				if width > widths[column] {
+					rowWidth += width - widths[column]
+					widths[column] = width
+				}
+			}
+
+			batch.append(row)
+
+			if batch.count >= batchSize || batch.count * (rowWidth + 8 * columns.count) >= byteBudget {
+				try execute()
+			}
+		}
+
+		if !batch.isEmpty {
+			try execute()
+		}
+
+		return BulkInsertReport(insertedRows: insertedRows, batches: batches, failedRows: failedRows)
+	}
+
+	private static func quote(_ identifier: String) -> String {
+		"\"" + identifier.split(separator: "\"", omittingEmptySubsequences: false).joined(separator: "\"\"") + "\""
+	}
+
+	/// The amount of bytes a value takes up in its column's parameter buffer.
+	private static func width(of value: BindableValue?) -> Int {
+		switch value {
+			case let string as String: return string.utf8.count + 1
+			case let bytes as [UInt8]: return bytes.count
+			case is ODBCDecimal: return Int(DECIMAL_STRING_CAPACITY)
+			default: return 8
+		}
+	}
+}
@@ -69,12 +69,9 @@ public class Connection {
 	/// - Throws: ``ODBCError/databaseError`` or ``ODBCError/general``.
 	public init(_ connectionType: ConnectionType, timeout: Int = 0) throws {
 		self.connectionType = connectionType
+		self.pool = nil
 		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
 
-		defer {
-			errorPointer.deallocate()
-		}
-
 		switch connectionType {
 			case let .odbcString(connStr):
 				if let c = createConnectionConnectionString(connStr, timeout, errorPointer) {
@@ -100,7 +97,56 @@ public class Connection {
 		}
 	}
 
-	// deinit { destroyConnection(connection) }
+	/// The pool this `Connection` was acquired from and is returned to when deinitialized.
+	let pool: ConnectionPool?
+
+	init(connection: OpaquePointer, connectionType: ConnectionType, pool: ConnectionPool) {
+		self.connection = connection
+		self.connectionType = connectionType
+		self.pool = pool
+	}
+
+	deinit {
+		if let pool = self.pool {
+			poolRelease(pool.poolPointer, self.connection)
+		} else {
+			destroyConnection(self.connection)
+		}
+	}
+
+	/// The amount of prepared statements this `Connection` keeps for reuse by ``statement(query:)`` after they are
+	/// released. 0 disables the cache.
+	public var statementCacheCapacity: Int {
+		get { connectionStatementCacheStatistics(self.connection).capacity }
+		set { connectionSetStatementCacheCapacity(self.connection, newValue) }
+	}
+
+	/// How often ``statement(query:)`` reused a prepared statement.
+	public var statementCacheStatistics: StatementCacheStatistics {
+		let stats = connectionStatementCacheStatistics(self.connection)
+		return StatementCacheStatistics(size: stats.size, hits: stats.hits, misses: stats.misses)
+	}
+
+	/// The amount of seconds ``Catalog`` lookups on this `Connection` are cached for. 0 disables the cache.
+	///
+	/// Connections acquired from a ``ConnectionPool`` share the pool's cache. The cache does not notice changes to
+	/// the schema of the database; call ``invalidateMetadataCache(table:)`` after altering a table.
+	public var metadataCacheTTL: Double {
+		get { Double(connectionMetadataCacheStatistics(self.connection).ttl) / 1000 }
+		set { connectionSetMetadataCacheTTL(self.connection, Int(newValue * 1000)) }
+	}
+
+	/// How often ``Catalog`` lookups were answered from the metadata cache.
+	public var metadataCacheStatistics: MetadataCacheStatistics {
+		let stats = connectionMetadataCacheStatistics(self.connection)
+		return MetadataCacheStatistics(size: stats.size, hits: stats.hits, misses: stats.misses)
+	}
+
+	/// Drops the cached column lookups that may have found columns of `table`, or every cached lookup if `table` is
+	/// `nil`.
+	public func invalidateMetadataCache(table: String? = nil) {
+		connectionInvalidateMetadataCache(self.connection, table)
+	}
 
 	/// Create a new `Statement`.
 	/// - Parameter query: The SQL query to pass to the `Statement`.
@@ -126,12 +172,14 @@ public class Connection {
 	/// Execute `query` on the database.
 	/// - Parameters:
 	///   - query: The SQL query to execute.
+	///   - rowsetSize: The amount of rows fetched from the driver at once. Rows in a rowset are read from memory, so
+	///   ``Result/next()`` only calls into the driver once every `rowsetSize` rows.
 	///   - timeout: The amount of seconds to wait for the query to execute. 0 means no timeout.
 	/// - Throws: `ODBCError`.
 	/// - Returns: `Result`.
-	public func execute(query: String, timeout: Int = 0) throws -> Result {
+	public func execute(query: String, rowsetSize: Int = 1, timeout: Int = 0) throws -> Result {
 		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
-		let resPointer = cExecute(connection, query, 1, timeout, errorPointer)
+		let resPointer = cExecute(connection, query, 1, rowsetSize, timeout, errorPointer)
 
 		guard !errorPointer.pointee.isValid else {
 			throw ODBCError.fromErrorPointer(errorPointer)
@@ -141,7 +189,7 @@ public class Connection {
 			throw ODBCError.unexpectedNull(name: "nanodbc::statement::execute")
 		}
 
-		return Result(resPointer: res)
+		return Result(resPointer: res, owner: self)
 	}
 
 	/// Disconnect from the database.
@@ -151,3 +199,27 @@ public class Connection {
 		}
 	}
 }
+
+/// Statistics about the prepared statement cache of a ``Connection``.
+public struct StatementCacheStatistics {
+	/// The amount of prepared statements currently waiting to be reused.
+	public let size: Int
+
+	/// The amount of statements that reused a prepared statement.
+	public let hits: Int
+
+	/// The amount of statements that had to be prepared.
+	public let misses: Int
+}
+
+/// Statistics about the metadata cache of a ``Connection`` or ``ConnectionPool``.
+public struct MetadataCacheStatistics {
+	/// The amount of catalog lookups currently cached.
+	public let size: Int
+
+	/// The amount of catalog lookups that were answered from the cache.
+	public let hits: Int
+
+	/// The amount of catalog lookups that had to query the database.
+	public let misses: Int
+}
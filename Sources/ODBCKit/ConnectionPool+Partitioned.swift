@@ -0,0 +1,154 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension ConnectionPool {
+	/// Runs `query` once for each set of values in `partitions`, each on its own connection and thread, and returns
+	/// the rows of all of them as one stream of batches.
+	///
+	/// ```swift
+	/// let batches = try pool.executePartitioned(
+	/// 	query: "SELECT * FROM \"orders\" WHERE \"region\" = ?;",
+	/// 	partitions: [["north"], ["south"], ["east"], ["west"]]
+	/// )
+	///
+	/// while let batch = try batches.next() {
+	/// 	process(batch)
+	/// }
+	/// ```
+	///
+	/// A connection is acquired for every partition and held until the returned ``ConnectionPool/PartitionedBatches``
+	/// is deinitialized. More partitions than the pool's `maxSize` could never all be acquired, so they are rejected
+	/// instead of waiting forever; connections acquired elsewhere are still waited for until they are released.
+	///
+	/// - Parameters:
+	///   - query: The query to run for each partition.
+	///   - partitions: The values to bind to the `?` parameters of `query`, one array per partition.
+	///   - rowsetSize: The amount of rows fetched from the driver at once.
+	///   - batchSize: The maximum amount of rows in each batch.
+	///   - timeout: The amount of seconds to wait for each query to execute. 0 means no timeout.
+	/// - Throws: ``ODBCError``, or ``ODBCError/programmingError(message:)`` if there are no partitions or more than
+	///   `maxSize`.
+	func executePartitioned(
+		query: String,
+		partitions: [[BindableValue?]],
+		rowsetSize: Int = 1000,
+		batchSize: Int = 1000,
+		timeout: Int = 0
+	) throws -> PartitionedBatches {
+		guard !partitions.isEmpty else {
+			throw ODBCError.programmingError(message: "executePartitioned requires at least one partition")
+		}
+
+		let maxSize = self.maxSize
+
+		guard partitions.count <= maxSize else {
+			throw ODBCError.programmingError(
+				message: "executePartitioned needs \(partitions.count) connections, but the pool allows \(maxSize)"
+			)
+		}
+
+		let statements = try partitions.map { values -> Statement in
+			let stmt = Statement(connection: try self.acquire(), query: query, timeout: timeout)
+
+			for (i, value) in values.enumerated() {
+				if let value = value {
+					try value.bind(stmtPointer: stmt.statementPointer, index: Int16(i))
+				} else if let errorPointer = stmtBindNull(stmt.statementPointer, Int16(i)) {
+					throw ODBCError.fromErrorPointer(errorPointer)
+				}
+			}
+
+			return stmt
+		}
+
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let query = statements.map { $0.statementPointer }.withUnsafeBufferPointer { pointers in
+			partitionedExecute(pointers.baseAddress!, pointers.count, rowsetSize, batchSize, timeout, errorPointer)
+		}
+
+		guard let q = query else { throw ODBCError.fromErrorPointer(errorPointer) }
+
+		return PartitionedBatches(query: q, statements: statements)
+	}
+
+	/// Splits `keyRange` into `partitions` slices of about equal size and runs `query` for each of them like
+	/// ``executePartitioned(query:partitions:rowsetSize:batchSize:timeout:)``.
+	///
+	/// The first two `?` parameters of `query` receive the inclusive lower and exclusive upper bound of a slice:
+	///
+	/// ```swift
+	/// let batches = try pool.executePartitioned(
+	/// 	query: "SELECT * FROM \"events\" WHERE \"id\" >= ? AND \"id\" < ?;",
+	/// 	keyRange: 0..<1_000_000,
+	/// 	partitions: 8
+	/// )
+	/// ```
+	///
+	/// - Throws: ``ODBCError``.
+	func executePartitioned(
+		query: String,
+		keyRange: Range<Int64>,
+		partitions: Int,
+		rowsetSize: Int = 1000,
+		batchSize: Int = 1000,
+		timeout: Int = 0
+	) throws -> PartitionedBatches {
+		let count = UInt64(max(partitions, 1))
+		// The width of a range can exceed `Int64.max`, but never `UInt64.max`.
+		let width = UInt64(bitPattern: keyRange.upperBound &- keyRange.lowerBound)
+		let (step, rest) = width.quotientAndRemainder(dividingBy: count)
+		// Every offset is at most `width`, so adding it wraps back into the range.
+		let bounds = (0...count).map { keyRange.lowerBound &+ Int64(bitPattern: step * $0 + min($0, rest)) }
+
+		return try self.executePartitioned(
+			query: query,
+			partitions: (0..<Int(count)).map { [bounds[$0], bounds[$0 + 1]] },
+			rowsetSize: rowsetSize,
+			batchSize: batchSize,
+			timeout: timeout
+		)
+	}
+
+	/// The rows of a query run in partitions, created with
+	/// ``ConnectionPool/executePartitioned(query:partitions:rowsetSize:batchSize:timeout:)``.
+	final class PartitionedBatches {
+		private let query: OpaquePointer
+		/// Keeps the connections of the partitions out of the pool until their queries have stopped.
+		private let statements: [Statement]
+
+		init(query: OpaquePointer, statements: [Statement]) {
+			self.query = query
+			self.statements = statements
+		}
+
+		deinit {
+			partitionedDestroy(self.query)
+		}
+
+		/// Waits for the next batch of any partition.
+		///
+		/// Batches are returned in the order they are read, so the rows of different partitions are interleaved.
+		///
+		/// - Throws: ``ODBCError`` if the query of any partition failed.
+		/// - Returns: The next batch, or `nil` once the rows of every partition have been returned.
+		public func next() throws -> Result.Batch? {
+			let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+			guard let cBatch = partitionedNext(self.query, errorPointer) else {
+				if errorPointer.pointee.isValid {
+					throw ODBCError.fromErrorPointer(errorPointer)
+				}
+
+				return nil
+			}
+
+			return Result.Batch(cBatch: cBatch.pointee)
+		}
+	}
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+/// A thread-safe pool of open ``Connection``s to the same database.
+///
+/// ```swift
+/// let pool = try ConnectionPool(.odbcString(connectionString), maxSize: 8)
+///
+/// let conn = try pool.acquire()
+/// let res = try conn.execute(query: "SELECT 1;")
+/// ```
+///
+/// An acquired `Connection` returns to the pool once it, and every `Statement` and `Result` created from it, have
+/// been deinitialized.
+public final class ConnectionPool {
+	public let connectionType: ConnectionType
+	let poolPointer: OpaquePointer
+
+	/// Creates a pool and opens `minSize` connections.
+	/// - Parameters:
+	///   - connectionType: The ``ConnectionType`` that describes how the driver and database details will be passed to
+	///     the ODBC driver.
+	///   - minSize: The amount of connections that are kept open while idle.
+	///   - maxSize: The maximum amount of open connections.
+	///   - idleTimeout: The amount of seconds after which idle connections above `minSize` are closed. 0 keeps them
+	///     open.
+	///   - validationQuery: A query that is run on an idle connection before handing it out. If `nil`, only the
+	///     driver is asked whether the connection is dead.
+	///   - timeout: The amount of seconds to wait when trying to establish a connection.
+	/// - Throws: ``ODBCError``.
+	public init(
+		_ connectionType: ConnectionType,
+		minSize: Int = 0,
+		maxSize: Int = 10,
+		idleTimeout: Int = 300,
+		validationQuery: String? = nil,
+		timeout: Int = 0
+	) throws {
+		self.connectionType = connectionType
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let pool: OpaquePointer? = Self.withOptions(minSize, maxSize, idleTimeout, validationQuery) { options in
+			switch connectionType {
+				case let .odbcString(connStr):
+					return poolCreateConnectionString(connStr, timeout, options, errorPointer)
+				case let .dataSource(dsn: dsn, username: username, password: password):
+					return poolCreateDSN(dsn, username, password, timeout, options, errorPointer)
+			}
+		}
+
+		guard let p = pool else {
+			if errorPointer.pointee.isValid {
+				throw ODBCError.fromErrorPointer(errorPointer)
+			} else {
+				throw ODBCError.unexpectedNull(name: "poolCreate")
+			}
+		}
+
+		self.poolPointer = p
+	}
+
+	deinit {
+		poolDestroy(self.poolPointer)
+	}
+
+	/// The amount of open connections, including acquired ones.
+	public var size: Int {
+		poolStatistics(self.poolPointer).size
+	}
+
+	/// The amount of open connections that are not acquired.
+	public var idleCount: Int {
+		poolStatistics(self.poolPointer).idle
+	}
+
+	/// The maximum amount of open connections.
+	public var maxSize: Int {
+		poolStatistics(self.poolPointer).maxSize
+	}
+
+	/// The amount of seconds ``Catalog`` lookups on the connections of this pool are cached for, like
+	/// ``Connection/metadataCacheTTL``. The connections share one cache.
+	public var metadataCacheTTL: Double {
+		get { Double(poolMetadataCacheStatistics(self.poolPointer).ttl) / 1000 }
+		set { poolSetMetadataCacheTTL(self.poolPointer, Int(newValue * 1000)) }
+	}
+
+	/// How often ``Catalog`` lookups on the connections of this pool were answered from the metadata cache.
+	public var metadataCacheStatistics: MetadataCacheStatistics {
+		let stats = poolMetadataCacheStatistics(self.poolPointer)
+		return MetadataCacheStatistics(size: stats.size, hits: stats.hits, misses: stats.misses)
+	}
+
+	/// Like ``Connection/invalidateMetadataCache(table:)``, for the cache the connections of this pool share.
+	public func invalidateMetadataCache(table: String? = nil) {
+		poolInvalidateMetadataCache(self.poolPointer, table)
+	}
+
+	/// Takes a live connection out of the pool, opening a new one if none is idle and the pool is not full.
+	/// - Parameter timeout: The amount of seconds to wait for a connection to be released if the pool is full. `nil`
+	///   waits indefinitely.
+	/// - Throws: ``ODBCError``.
+	/// - Returns: `Connection`.
+	public func acquire(timeout: Double? = nil) throws -> Connection {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let waitTimeout = timeout.map { Int($0 * 1000) } ?? -1
+
+		guard let c = poolAcquire(self.poolPointer, waitTimeout, errorPointer) else {
+			if errorPointer.pointee.isValid {
+				throw ODBCError.fromErrorPointer(errorPointer)
+			} else {
+				throw ODBCError.unexpectedNull(name: "poolAcquire")
+			}
+		}
+
+		return Connection(connection: c, connectionType: self.connectionType, pool: self)
+	}
+
+	/// Acquires a connection, passes it to `body`, and returns it to the pool afterwards.
+	/// - Throws: ``ODBCError``, or whatever `body` throws.
+	public func withConnection<T>(timeout: Double? = nil, _ body: (Connection) throws -> T) throws -> T {
+		try body(try self.acquire(timeout: timeout))
+	}
+
+	private static func withOptions(
+		_ minSize: Int,
+		_ maxSize: Int,
+		_ idleTimeout: Int,
+		_ validationQuery: String?,
+		_ body: (CConnectionPoolOptions) -> OpaquePointer?
+	) -> OpaquePointer? {
+		guard let query = validationQuery else {
+			return body(CConnectionPoolOptions(
+				minSize: minSize, maxSize: maxSize, idleTimeout: idleTimeout, validationQuery: nil
+			))
+		}
+
+		return query.withCString { q in
+			body(CConnectionPoolOptions(
+				minSize: minSize, maxSize: maxSize, idleTimeout: idleTimeout, validationQuery: q
+			))
+		}
+	}
+}
@@ -60,7 +60,7 @@ public struct ODBCDate: Equatable, Codable, CustomDebugStringConvertible {
 	}
 
 	var cDate: CDate {
-		CDate(month: Int16(self.year), day: Int16(self.month), year: Int16(self.day))
+		CDate(month: Int16(self.month), day: Int16(self.day), year: Int16(self.year))
 	}
 }
 
@@ -108,6 +108,85 @@ public struct ODBCTimeStamp: Equatable, Codable {
 	}
 }
 
+/// An exact decimal number, as stored in `DECIMAL` and `NUMERIC` columns.
+///
+/// Holds up to 38 significant digits with up to 38 of them after the decimal point, so values read through
+/// ``Result/Value/decimal`` keep every digit that `Double` would round away.
+public struct ODBCDecimal: Hashable, Codable, LosslessStringConvertible {
+	let cDecimal: CDecimal
+
+	/// The amount of digits after the decimal point.
+	public var scale: Int {
+		Int(self.cDecimal.scale)
+	}
+
+	public var isNegative: Bool {
+		self.cDecimal.negative
+	}
+
+	/// The closest `Double` to this number.
+	public var doubleValue: Double {
+		decimalToDouble(self.cDecimal)
+	}
+
+	/// This number with exactly ``scale`` digits after the decimal point, like `-1234.50`.
+	public var description: String {
+		var buffer = [CChar](repeating: 0, count: Int(DECIMAL_STRING_CAPACITY))
+		decimalFormat(self.cDecimal, &buffer)
+		return String(cString: buffer)
+	}
+
+	/// Parses a number like `-1234.50` or `1.5E3`. Returns `nil` if `description` is not a number or has more than
+	/// 38 significant digits.
+	public init?(_ description: String) {
+		var cDecimal = CDecimal()
+		guard decimalParse(description, UInt(description.utf8.count), &cDecimal) else { return nil }
+		self.cDecimal = cDecimal
+	}
+
+	/// Creates the number `significand * 10^-scale`.
+	/// - Precondition: `scale` is between 0 and 38.
+	public init(significand: Int64, scale: Int) {
+		precondition((0...38).contains(scale), "The scale of an ODBCDecimal must be between 0 and 38")
+		self.cDecimal = CDecimal(low: significand.magnitude, high: 0, scale: Int16(scale), negative: significand < 0)
+	}
+
+	init(cDecimal: CDecimal) {
+		self.cDecimal = cDecimal
+	}
+
+	public init(from decoder: Decoder) throws {
+		let container = try decoder.singleValueContainer()
+		let string = try container.decode(String.self)
+
+		guard let decimal = Self(string) else {
+			throw DecodingError.dataCorruptedError(in: container, debugDescription: "\(string) is not a decimal number")
+		}
+
+		self = decimal
+	}
+
+	public func encode(to encoder: Encoder) throws {
+		var container = encoder.singleValueContainer()
+		try container.encode(self.description)
+	}
+
+	/// Numbers that only differ in trailing zeros after the decimal point, like `1.5` and `1.50`, are equal.
+	public static func == (lhs: Self, rhs: Self) -> Bool {
+		let l = decimalNormalized(lhs.cDecimal)
+		let r = decimalNormalized(rhs.cDecimal)
+		return l.low == r.low && l.high == r.high && l.scale == r.scale && l.negative == r.negative
+	}
+
+	public func hash(into hasher: inout Hasher) {
+		let normalized = decimalNormalized(self.cDecimal)
+		hasher.combine(normalized.low)
+		hasher.combine(normalized.high)
+		hasher.combine(normalized.scale)
+		hasher.combine(normalized.negative)
+	}
+}
+
 /// SQL Data Types.
 ///
 /// The documentation comments on each `case` are from [Microsoft's documentation on DSL Data Types](https://docs.microsoft.com/en-us/sql/odbc/reference/appendixes/sql-data-types?view=sql-server-ver15).
@@ -0,0 +1,36 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// Exports this `Result` as an [Arrow C stream](https://arrow.apache.org/docs/format/CStreamInterface.html)
+	/// that yields one record batch per rowset.
+	///
+	/// Execute the query with a `rowsetSize` larger than 1 so each batch holds more than one row. Integer and floating
+	/// point columns are handed to the consumer without copying. Once the stream has been exported, only read this
+	/// `Result` through the stream.
+	///
+	/// - Parameter stream: The uninitialized stream to fill in. The consumer is responsible for calling its
+	///   `release` callback.
+	func exportArrowStream(to stream: UnsafeMutablePointer<ArrowArrayStream>) {
+		resultExportArrowStream(self.resPointer, stream)
+	}
+
+	/// Exports the columns of this `Result` as an
+	/// [Arrow C schema](https://arrow.apache.org/docs/format/CDataInterface.html).
+	///
+	/// - Parameter schema: The uninitialized schema to fill in. The consumer is responsible for calling its
+	///   `release` callback.
+	/// - Throws: ``ODBCError``.
+	func exportArrowSchema(to schema: UnsafeMutablePointer<ArrowSchema>) throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		if !resultExportArrowSchema(self.resPointer, schema, errorPointer), errorPointer.pointee.isValid {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+	}
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// A block of rows stored column by column, retrieved with ``Result/fetchBatch(maxRows:)``.
+	struct Batch {
+		/// The values of a ``Result/Batch/Column``.
+		///
+		/// Rows that are `null` hold `0`, an empty `String`/`Array`, or a zeroed date/time in their place; use
+		/// ``Result/Batch/Column/isNull(at:)`` to tell them apart.
+		public enum Values {
+			case int64([Int64])
+			case double([Double])
+			case date([ODBCDate])
+			case time([ODBCTime])
+			case timeStamp([ODBCTimeStamp])
+			case string([String])
+			case bytes([[UInt8]])
+		}
+
+		/// A single column of a ``Result/Batch``.
+		public struct Column {
+			public let values: Values
+			let validity: [UInt8]
+
+			/// If the value in `row` is `null`.
+			public func isNull(at row: Int) -> Bool {
+				self.validity[row / 8] & (1 << UInt8(row % 8)) == 0
+			}
+		}
+
+		/// The amount of rows in this `Batch`.
+		public let rowCount: Int
+
+		/// The columns of this `Batch`, in the same order as the columns of the `Result`.
+		public let columns: [Column]
+
+		init(cBatch: CBatch) {
+			self.rowCount = cBatch.rowCount
+			self.columns = UnsafeBufferPointer(start: cBatch.columns, count: Int(cBatch.columnCount))
+				.map { Column(cColumn: $0, rowCount: cBatch.rowCount) }
+		}
+	}
+
+	/// Advances up to `maxRows` rows and returns their values column by column.
+	///
+	/// All values are copied out of the driver's buffers in a single call, which is considerably faster than
+	/// reading each value through the subscripts of `Result`. The buffers they are gathered in are kept and reused by
+	/// the next call, until the `Result` is deinitialized. Execute the query with a `rowsetSize` larger than 1
+	/// to also fetch the rows from the driver in blocks.
+	///
+	/// - Parameter maxRows: The maximum amount of rows to retrieve.
+	/// - Throws: ``ODBCError``.
+	/// - Returns: The retrieved rows, or `nil` if there are no rows left.
+	func fetchBatch(maxRows: Int) throws -> Batch? {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		guard let cBatch = resultFetchBatch(self.resPointer, maxRows, self.handle.batch, errorPointer) else {
+			if errorPointer.pointee.isValid {
+				throw ODBCError.fromErrorPointer(errorPointer)
+			} else {
+				throw ODBCError.unexpectedNull(name: "resultFetchBatch")
+			}
+		}
+
+		// The values are copied out, so the storage is refilled by the next call.
+		self.handle.batch = cBatch
+
+		guard cBatch.pointee.rowCount > 0 else { return nil }
+
+		return Batch(cBatch: cBatch.pointee)
+	}
+
+	/// Reads batches of rows like ``Result/fetchBatch(maxRows:)``, fetching each batch on a background thread while
+	/// the previous one is being processed.
+	///
+	/// ```swift
+	/// let batches = try res.prefetchBatches(maxRows: 1000)
+	///
+	/// while let batch = try batches.next() {
+	/// 	process(batch)
+	/// }
+	/// ```
+	///
+	/// The `Result` must not be used while the returned ``Result/PrefetchedBatches`` is alive. Execute the query with
+	/// a `rowsetSize` of `maxRows` so that each batch is a single round trip to the database.
+	///
+	/// - Parameter maxRows: The maximum amount of rows in each batch.
+	/// - Throws: ``ODBCError``.
+	func prefetchBatches(maxRows: Int) throws -> PrefetchedBatches {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		guard let prefetcher = resultPrefetchBatches(self.resPointer, maxRows, errorPointer) else {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+
+		return PrefetchedBatches(prefetcher: prefetcher, result: self)
+	}
+
+	/// The batches of a `Result` that are fetched in the background, created with
+	/// ``Result/prefetchBatches(maxRows:)``.
+	final class PrefetchedBatches {
+		private let prefetcher: OpaquePointer
+		/// Keeps the result, and whatever owns it, alive while rows are being fetched from it.
+		private let result: Result
+
+		init(prefetcher: OpaquePointer, result: Result) {
+			self.prefetcher = prefetcher
+			self.result = result
+		}
+
+		deinit {
+			prefetcherDestroy(self.prefetcher)
+		}
+
+		/// Waits for the batch fetched in the background and starts fetching the one after it.
+		/// - Throws: ``ODBCError``.
+		/// - Returns: The next batch, or `nil` if there are no rows left.
+		public func next() throws -> Batch? {
+			let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+			guard let cBatch = prefetcherNext(self.prefetcher, errorPointer) else {
+				if errorPointer.pointee.isValid {
+					throw ODBCError.fromErrorPointer(errorPointer)
+				}
+
+				return nil
+			}
+
+			return Batch(cBatch: cBatch.pointee)
+		}
+	}
+
+	/// Converts the timestamps in the column at `index`, from the current row to the end of the current rowset, to
+	/// microseconds since 1970-01-01 00:00:00 with a single pass over the driver's buffer.
+	///
+	/// The `Result` is left on the last converted row, so every row is visited once by:
+	///
+	/// ```swift
+	/// while try res.next() {
+	/// 	micros += try res.epochMicroseconds(at: 0)
+	/// }
+	/// ```
+	///
+	/// Execute the query with a `rowsetSize` larger than 1 to convert more than one row per call.
+	///
+	/// - Parameter index: The index of the column.
+	/// - Throws: ``ODBCError``.
+	/// - Returns: The converted timestamps, with `nil` in place of `null` values.
+	func epochMicroseconds(at index: Int) throws -> [Int64?] {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let capacity = max(try self.rows, 1)
+		var values = [Int64](repeating: 0, count: capacity)
+		var validity = [UInt8](repeating: 0, count: (capacity + 7) / 8)
+
+		let count = values.withUnsafeMutableBufferPointer { values in
+			validity.withUnsafeMutableBufferPointer { validity in
+				resultGetEpochMicroseconds(
+					self.resPointer, Int16(index), values.baseAddress!, validity.baseAddress!, capacity, errorPointer
+				)
+			}
+		}
+
+		guard count >= 0 else { throw ODBCError.fromErrorPointer(errorPointer) }
+
+		return (0..<count).map { row in
+			validity[row / 8] & (1 << UInt8(row % 8)) == 0 ? nil : values[row]
+		}
+	}
+}
+
+extension Result.Batch.Column {
+	init(cColumn: CBatchColumn, rowCount: Int) {
+		self.validity = Array(UnsafeBufferPointer(start: cColumn.validity, count: (rowCount + 7) / 8))
+
+		switch cColumn.type {
+			case .int64Column:
+				self.values = .int64(Self.copy(cColumn, as: Int64.self, count: rowCount))
+			case .doubleColumn:
+				self.values = .double(Self.copy(cColumn, as: Double.self, count: rowCount))
+			case .dateColumn:
+				self.values = .date(Self.copy(cColumn, as: CDate.self, count: rowCount).map(ODBCDate.init(cDate:)))
+			case .timeColumn:
+				self.values = .time(Self.copy(cColumn, as: CTime.self, count: rowCount).map(ODBCTime.init(cTime:)))
+			case .timeStampColumn:
+				self.values = .timeStamp(
+					Self.copy(cColumn, as: CTimeStamp.self, count: rowCount).map(ODBCTimeStamp.init(cTimeStamp:))
+				)
+			case .binaryColumn:
+				self.values = .bytes(Self.slices(cColumn, count: rowCount).map { Array($0) })
+			default:
+				self.values = .string(Self.slices(cColumn, count: rowCount).map { String(decoding: $0, as: UTF8.self) })
+		}
+	}
+
+	private static func copy<T>(_ cColumn: CBatchColumn, as type: T.Type, count: Int) -> [T] {
+		guard let values = cColumn.values else { return [] }
+
+		return Array(UnsafeBufferPointer(start: values.assumingMemoryBound(to: T.self), count: count))
+	}
+
+	private static func slices(_ cColumn: CBatchColumn, count: Int) -> [UnsafeBufferPointer<UInt8>] {
+		guard let offsets = cColumn.offsets else { return [] }
+
+		let bytes = cColumn.values?.assumingMemoryBound(to: UInt8.self)
+
+		return (0..<count).map { row in
+			UnsafeBufferPointer(start: bytes.map { $0 + Int(offsets[row]) }, count: Int(offsets[row + 1] - offsets[row]))
+		}
+	}
+}
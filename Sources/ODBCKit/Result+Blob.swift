@@ -0,0 +1,142 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// The value of a long data (`BLOB`, `bytea`, `TEXT`, …) column in the current row, read piece by piece.
+	///
+	/// ```swift
+	/// let res = try conn.execute(query: "SELECT \"data\" FROM \"files\" WHERE \"id\" = 1;")
+	/// _ = try res.next()
+	///
+	/// let blob = try res.blob(at: 0)
+	///
+	/// while let chunk = try blob.readChunk() {
+	/// 	hasher.update(chunk)
+	/// }
+	/// ```
+	///
+	/// Only the chunk that is being read is held in memory, so values far larger than ``Result/Value/bytes`` could
+	/// handle can be piped to a file or a hasher. Character data is returned in the driver's encoding. A `Blob` can
+	/// no longer be read once its `Result` has moved to another row.
+	final class Blob {
+		let blobPointer: OpaquePointer
+		let owner: AnyObject?
+
+		/// The maximum amount of bytes returned by ``readChunk()`` and by iterating over the `Blob`.
+		public let chunkSize: Int
+
+		init(blobPointer: OpaquePointer, owner: AnyObject?, chunkSize: Int) {
+			self.blobPointer = blobPointer
+			self.owner = owner
+			self.chunkSize = max(chunkSize, 1)
+		}
+
+		deinit {
+			blobDestroy(self.blobPointer)
+		}
+
+		/// If the value is null. Only known once something has been read.
+		public var isNull: Bool {
+			blobIsNull(self.blobPointer)
+		}
+
+		/// The amount of bytes that have not been read yet, if the driver reports it. Only known once something has
+		/// been read.
+		public var remainingLength: Int? {
+			let remaining = blobRemainingLength(self.blobPointer)
+			return remaining < 0 ? nil : Int(remaining)
+		}
+
+		/// Reads the next bytes of the value into `buffer`, with a single call to the driver.
+		/// - Throws: ``ODBCError``.
+		/// - Returns: The amount of bytes read, or 0 once the whole value has been read.
+		public func read(into buffer: UnsafeMutableRawBufferPointer) throws -> Int {
+			guard let base = buffer.baseAddress, buffer.count > 0 else { return 0 }
+
+			let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+			let read = resultReadBlob(self.blobPointer, base, UInt(buffer.count), errorPointer)
+
+			if read < 0, errorPointer.pointee.isValid {
+				throw ODBCError.fromErrorPointer(errorPointer)
+			}
+
+			return max(read, 0)
+		}
+
+		/// Reads the next up to ``chunkSize`` bytes of the value.
+		/// - Throws: ``ODBCError``.
+		/// - Returns: The bytes read, or `nil` once the whole value has been read.
+		public func readChunk() throws -> [UInt8]? {
+			let chunk = try [UInt8](unsafeUninitializedCapacity: self.chunkSize) { buffer, count in
+				count = try self.read(into: UnsafeMutableRawBufferPointer(buffer))
+			}
+
+			return chunk.isEmpty ? nil : chunk
+		}
+	}
+
+	/// Opens the value of the column at `index` in the current row for reading it piece by piece.
+	/// - Parameters:
+	///   - index: The index of the column. The column must not be bound, which long data columns never are.
+	///   - chunkSize: The maximum amount of bytes returned by ``Blob/readChunk()``.
+	/// - Throws: ``ODBCError``.
+	func blob(at index: Int, chunkSize: Int = 64 * 1024) throws -> Blob {
+		try self.openBlob(.left(Int16(index)), chunkSize: chunkSize)
+	}
+
+	/// Opens the value of the column called `name` in the current row for reading it piece by piece.
+	/// - Parameters:
+	///   - name: The name of the column. The column must not be bound, which long data columns never are.
+	///   - chunkSize: The maximum amount of bytes returned by ``Blob/readChunk()``.
+	/// - Throws: ``ODBCError``.
+	func blob(named name: String, chunkSize: Int = 64 * 1024) throws -> Blob {
+		try self.openBlob(.right(name), chunkSize: chunkSize)
+	}
+
+	private func openBlob(_ numOrName: ODBCEither<Int16, String>, chunkSize: Int) throws -> Blob {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let blob: OpaquePointer?
+
+		switch numOrName {
+			case var .left(index):
+				blob = resultOpenBlob(self.resPointer, &index, nil, errorPointer)
+			case let .right(name):
+				blob = resultOpenBlob(self.resPointer, nil, name, errorPointer)
+		}
+
+		guard let b = blob else {
+			if errorPointer.pointee.isValid {
+				throw ODBCError.fromErrorPointer(errorPointer)
+			} else {
+				throw ODBCError.unexpectedNull(name: "resultOpenBlob")
+			}
+		}
+
+		return Blob(blobPointer: b, owner: self.owner, chunkSize: chunkSize)
+	}
+}
+
+@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+extension Result.Blob: AsyncSequence {
+	public typealias Element = [UInt8]
+
+	/// Yields the chunks of a ``Result/Blob`` until the whole value has been read.
+	public struct AsyncIterator: AsyncIteratorProtocol {
+		let blob: Result.Blob
+
+		public mutating func next() async throws -> [UInt8]? {
+			try self.blob.readChunk()
+		}
+	}
+
+	public func makeAsyncIterator() -> AsyncIterator {
+		AsyncIterator(blob: self)
+	}
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// A column of a `Result` whose name has already been resolved to its index.
+	///
+	/// Accessing a value by name looks the name up again for every value that is read. When reading the same
+	/// columns of many rows, resolve them once with ``Result/column(named:)`` and subscript the `Result` with the
+	/// `ColumnRef` instead.
+	struct ColumnRef: Hashable {
+		/// The name of the column.
+		public let name: String
+
+		/// The index of the column.
+		public let index: Int
+	}
+
+	/// Resolves the column called `name`.
+	/// - Throws: ``ODBCError`` if there is no such column.
+	func column(named name: String) throws -> ColumnRef {
+		ColumnRef(name: name, index: try self.index(of: name))
+	}
+
+	/// Resolves the columns called `names`, in order.
+	/// - Throws: ``ODBCError`` if any of the columns does not exist.
+	func columns(named names: [String]) throws -> [ColumnRef] {
+		try names.map(self.column(named:))
+	}
+
+	subscript(column: ColumnRef) -> Self.Value? {
+		mutating get {
+			Self.Value(numOrName: .left(Int16(column.index)), handle: self.handle)
+		}
+	}
+}
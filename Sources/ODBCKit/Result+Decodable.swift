@@ -0,0 +1,496 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// Decodes the current row as a `T`, reading each coding key of `T` from the column with the same name.
+	///
+	/// ```swift
+	/// struct User: Decodable {
+	/// 	let id: Int
+	/// 	let name: String
+	/// 	let email: String?
+	/// }
+	///
+	/// while try res.next() {
+	/// 	let user = try res.decode(User.self)
+	/// }
+	/// ```
+	///
+	/// A key that matches no column exactly matches the column whose name only differs in case, so `userId` also
+	/// finds a `userid` column folded to lower case by the database. Optional properties without a column decode as
+	/// `nil`. Types that decode from a single value, like `Int` or ``ODBCDate``, are read from the first column.
+	///
+	/// Values are converted where no precision is lost: integer columns decode as any integer type they fit into, and
+	/// as `Double`, `Bool` or `String`; `DECIMAL` and other text columns decode as numbers they can be parsed as, or as
+	/// ``ODBCDecimal``.
+	///
+	/// To decode many rows, ``rows(as:batchSize:)`` is considerably faster.
+	///
+	/// - Throws: ``ODBCError``, or `DecodingError` if a value does not match the property it is decoded as.
+	func decode<T: Decodable>(_ type: T.Type = T.self) throws -> T {
+		let plan = try self.columnPlan
+
+		return try RowDecoder(plan: plan) { column in try self.cell(at: column, type: plan.types[column]) }.decode(type)
+	}
+
+	/// Decodes the remaining rows as `T`s, like ``decode(_:)``.
+	///
+	/// The column and type every coding key is read from are resolved once, and the rows are fetched `batchSize` at a
+	/// time with ``fetchBatch(maxRows:)``, so every batch crosses into the driver layer once instead of once for every
+	/// value.
+	///
+	/// - Parameters:
+	///   - type: The type to decode each row as.
+	///   - batchSize: The maximum amount of rows fetched at once.
+	/// - Throws: ``ODBCError``, or `DecodingError` if a value does not match the property it is decoded as.
+	func rows<T: Decodable>(as type: T.Type = T.self, batchSize: Int = 1000) throws -> [T] {
+		let plan = try self.columnPlan
+		var rows: [T] = []
+
+		while let batch = try self.fetchBatch(maxRows: batchSize) {
+			rows.reserveCapacity(rows.count + batch.rowCount)
+
+			for row in 0..<batch.rowCount {
+				rows.append(try RowDecoder(plan: plan) { column in batch.columns[column].cell(at: row) }.decode(type))
+			}
+		}
+
+		return rows
+	}
+}
+
+// MARK: - Column plan
+
+extension Result {
+	/// The plan of the current result set, which is resolved once and shared by every copy of this result, so that
+	/// decoding row by row does not look up the names and types of the columns again for each row.
+	var columnPlan: ColumnPlan {
+		get throws {
+			if let plan = self.handle.plan {
+				return plan
+			}
+
+			let plan = try ColumnPlan(result: self)
+			self.handle.plan = plan
+
+			return plan
+		}
+	}
+}
+
+/// The column every coding key is read from, and the type ``Result/fetchBatch(maxRows:)`` stores it as.
+final class ColumnPlan {
+	let names: [String]
+	let types: [BatchColumnType]
+	private var indices: [String: Int] = [:]
+
+	init(result: Result) throws {
+		let count = try result.columns
+		var names: [String] = []
+		var types: [BatchColumnType] = []
+
+		for column in 0..<count {
+			let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+			let type = resultColumnBatchType(result.resPointer, Int16(column), errorPointer)
+
+			guard !errorPointer.pointee.isValid else { throw ODBCError.fromErrorPointer(errorPointer) }
+
+			names.append(try result.name(of: column))
+			types.append(type)
+		}
+
+		self.names = names
+		self.types = types
+	}
+
+	/// The index of the column `key` is read from, or `nil` if there is none.
+	func column(for key: CodingKey) -> Int? {
+		self.column(named: key.stringValue)
+	}
+
+	/// The index of the column called `name`, or of the only column whose name differs from it in case.
+	func column(named name: String) -> Int? {
+		// Resolved once per name; -1 marks names without a column.
+		if let column = self.indices[name] {
+			return column >= 0 ? column : nil
+		}
+
+		var column = self.names.firstIndex(of: name)
+
+		if column == nil {
+			let folded = self.names.indices.filter { self.names[$0].lowercased() == name.lowercased() }
+			column = folded.count == 1 ? folded[0] : nil
+		}
+
+		self.indices[name] = column ?? -1
+		return column
+	}
+}
+
+// MARK: - Values
+
+/// A single value of a row, as stored by ``Result/fetchBatch(maxRows:)``.
+enum Cell {
+	case null
+	case int64(Int64)
+	case double(Double)
+	case string(String)
+	case bytes([UInt8])
+	case date(ODBCDate)
+	case time(ODBCTime)
+	case timeStamp(ODBCTimeStamp)
+}
+
+extension Result {
+	func cell(at column: Int, type: BatchColumnType) throws -> Cell {
+		let value = Value(numOrName: .left(Int16(column)), handle: self.handle)
+		let cell: Cell?
+
+		switch type {
+			case .int64Column: cell = try value.int64.map(Cell.int64)
+			case .doubleColumn: cell = try value.double.map(Cell.double)
+			case .dateColumn: cell = try value.date.map(Cell.date)
+			case .timeColumn: cell = try value.time.map(Cell.time)
+			case .timeStampColumn: cell = try value.timeStamp.map(Cell.timeStamp)
+			case .binaryColumn: cell = try value.bytes.map(Cell.bytes)
+			default: cell = try value.string.map(Cell.string)
+		}
+
+		return cell ?? .null
+	}
+}
+
+extension Result.Batch.Column {
+	func cell(at row: Int) -> Cell {
+		guard !self.isNull(at: row) else { return .null }
+
+		switch self.values {
+			case let .int64(values): return .int64(values[row])
+			case let .double(values): return .double(values[row])
+			case let .date(values): return .date(values[row])
+			case let .time(values): return .time(values[row])
+			case let .timeStamp(values): return .timeStamp(values[row])
+			case let .string(values): return .string(values[row])
+			case let .bytes(values): return .bytes(values[row])
+		}
+	}
+}
+
+/// A type that is read directly from a ``Cell`` instead of through its `Decodable` conformance.
+protocol CellDecodable {
+	init?(cell: Cell)
+}
+
+extension CellDecodable {
+	static func decode(from decoder: ValueDecoder) throws -> Self {
+		try decoder.decodeCell(Self.self)
+	}
+}
+
+extension CellDecodable where Self: FixedWidthInteger {
+	init?(cell: Cell) {
+		switch cell {
+			case let .int64(value): self.init(exactly: value)
+			case let .double(value): self.init(exactly: value)
+			case let .string(value):
+				guard let parsed = Self(value) ?? Double(value).flatMap({ Self(exactly: $0) }) else { return nil }
+				self = parsed
+			default: return nil
+		}
+	}
+}
+
+extension Int: CellDecodable {}
+extension Int8: CellDecodable {}
+extension Int16: CellDecodable {}
+extension Int32: CellDecodable {}
+extension Int64: CellDecodable {}
+extension UInt: CellDecodable {}
+extension UInt8: CellDecodable {}
+extension UInt16: CellDecodable {}
+extension UInt32: CellDecodable {}
+extension UInt64: CellDecodable {}
+
+extension Double: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .int64(value): self.init(value)
+			case let .double(value): self = value
+			case let .string(value): self.init(value)
+			default: return nil
+		}
+	}
+}
+
+extension Float: CellDecodable {
+	init?(cell: Cell) {
+		guard let value = Double(cell: cell) else { return nil }
+		self.init(value)
+	}
+}
+
+extension Bool: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .int64(value): self = value != 0
+			case let .double(value): self = value != 0
+			case let .string(value):
+				switch value.lowercased() {
+					case "1", "true", "t", "yes", "y": self = true
+					case "0", "false", "f", "no", "n": self = false
+					default: return nil
+				}
+			default: return nil
+		}
+	}
+}
+
+extension String: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .string(value): self = value
+			case let .int64(value): self = value.description
+			case let .double(value): self = value.description
+			default: return nil
+		}
+	}
+}
+
+extension Array: CellDecodable where Element == UInt8 {
+	init?(cell: Cell) {
+		switch cell {
+			case let .bytes(value): self = value
+			case let .string(value): self.init(value.utf8)
+			default: return nil
+		}
+	}
+}
+
+extension ODBCDate: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .date(value): self = value
+			case let .timeStamp(value): self = value.date
+			default: return nil
+		}
+	}
+}
+
+extension ODBCTime: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .time(value): self = value
+			case let .timeStamp(value): self.init(hour: value.hour, minute: value.minute, second: value.second)
+			default: return nil
+		}
+	}
+}
+
+extension ODBCTimeStamp: CellDecodable {
+	init?(cell: Cell) {
+		switch cell {
+			case let .timeStamp(value): self = value
+			case let .date(value): self.init(date: value, hour: 0, minute: 0, second: 0, fractionalSecond: 0)
+			default: return nil
+		}
+	}
+}
+
+// MARK: - Decoders
+
+/// Decodes a row, reading the value of each coding key from its column in the ``ColumnPlan``.
+struct RowDecoder: Decoder {
+	let plan: ColumnPlan
+	let cell: (Int) throws -> Cell
+	var codingPath: [CodingKey] = []
+	var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+	init(plan: ColumnPlan, cell: @escaping (Int) throws -> Cell) {
+		self.plan = plan
+		self.cell = cell
+	}
+
+	func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		// Types made of a single value, like `Int` or `ODBCDate`, are read from the first column.
+		if type is CellDecodable.Type {
+			return try self.value(at: 0, codingPath: self.codingPath).decode(type)
+		}
+
+		return try T(from: self)
+	}
+
+	func value(at column: Int, codingPath: [CodingKey]) throws -> ValueDecoder {
+		guard column < self.plan.types.count else {
+			throw DecodingError.valueNotFound(
+				Cell.self,
+				DecodingError.Context(codingPath: codingPath, debugDescription: "The result has no column \(column).")
+			)
+		}
+
+		return ValueDecoder(cell: try self.cell(column), codingPath: codingPath)
+	}
+
+	func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+		KeyedDecodingContainer(RowContainer<Key>(decoder: self))
+	}
+
+	func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+		throw DecodingError.typeMismatch(
+			[Any].self,
+			DecodingError.Context(codingPath: self.codingPath, debugDescription: "A row can only be decoded by key.")
+		)
+	}
+
+	func singleValueContainer() throws -> SingleValueDecodingContainer {
+		try self.value(at: 0, codingPath: self.codingPath)
+	}
+}
+
+struct RowContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+	let decoder: RowDecoder
+
+	var codingPath: [CodingKey] { self.decoder.codingPath }
+
+	var allKeys: [Key] {
+		self.decoder.plan.names.compactMap(Key.init(stringValue:))
+	}
+
+	func contains(_ key: Key) -> Bool {
+		self.decoder.plan.column(for: key) != nil
+	}
+
+	private func value(forKey key: Key) throws -> ValueDecoder {
+		guard let column = self.decoder.plan.column(for: key) else {
+			throw DecodingError.keyNotFound(
+				key,
+				DecodingError.Context(
+					codingPath: self.codingPath,
+					debugDescription: "No column is called \(key.stringValue)."
+				)
+			)
+		}
+
+		return try self.decoder.value(at: column, codingPath: self.codingPath + [key])
+	}
+
+	func decodeNil(forKey key: Key) throws -> Bool {
+		try self.value(forKey: key).decodeNil()
+	}
+
+	func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try self.value(forKey: key).decode(type) }
+	func decode(_ type: String.Type, forKey key: Key) throws -> String { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try self.value(forKey: key).decode(type) }
+	func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try self.value(forKey: key).decode(type) }
+	func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try self.value(forKey: key).decode(type) }
+
+	func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+		try self.value(forKey: key).decode(type)
+	}
+
+	func nestedContainer<NestedKey: CodingKey>(
+		keyedBy type: NestedKey.Type,
+		forKey key: Key
+	) throws -> KeyedDecodingContainer<NestedKey> {
+		try self.value(forKey: key).container(keyedBy: type)
+	}
+
+	func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+		try self.value(forKey: key).unkeyedContainer()
+	}
+
+	/// The superclass of a class is decoded from the same row.
+	func superDecoder() throws -> Decoder {
+		self.decoder
+	}
+
+	func superDecoder(forKey key: Key) throws -> Decoder {
+		try self.value(forKey: key)
+	}
+}
+
+/// Decodes the value of a single column.
+struct ValueDecoder: Decoder, SingleValueDecodingContainer {
+	let cell: Cell
+	let codingPath: [CodingKey]
+	var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+	func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+		throw DecodingError.typeMismatch(
+			type,
+			DecodingError.Context(codingPath: self.codingPath, debugDescription: "A column holds a single value.")
+		)
+	}
+
+	func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+		throw DecodingError.typeMismatch(
+			[Any].self,
+			DecodingError.Context(codingPath: self.codingPath, debugDescription: "A column holds a single value.")
+		)
+	}
+
+	func singleValueContainer() throws -> SingleValueDecodingContainer {
+		self
+	}
+
+	func decodeNil() -> Bool {
+		if case .null = self.cell { return true } else { return false }
+	}
+
+	func decode(_ type: Bool.Type) throws -> Bool { try self.decodeCell(type) }
+	func decode(_ type: String.Type) throws -> String { try self.decodeCell(type) }
+	func decode(_ type: Double.Type) throws -> Double { try self.decodeCell(type) }
+	func decode(_ type: Float.Type) throws -> Float { try self.decodeCell(type) }
+	func decode(_ type: Int.Type) throws -> Int { try self.decodeCell(type) }
+	func decode(_ type: Int8.Type) throws -> Int8 { try self.decodeCell(type) }
+	func decode(_ type: Int16.Type) throws -> Int16 { try self.decodeCell(type) }
+	func decode(_ type: Int32.Type) throws -> Int32 { try self.decodeCell(type) }
+	func decode(_ type: Int64.Type) throws -> Int64 { try self.decodeCell(type) }
+	func decode(_ type: UInt.Type) throws -> UInt { try self.decodeCell(type) }
+	func decode(_ type: UInt8.Type) throws -> UInt8 { try self.decodeCell(type) }
+	func decode(_ type: UInt16.Type) throws -> UInt16 { try self.decodeCell(type) }
+	func decode(_ type: UInt32.Type) throws -> UInt32 { try self.decodeCell(type) }
+	func decode(_ type: UInt64.Type) throws -> UInt64 { try self.decodeCell(type) }
+
+	func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		if let cellType = type as? CellDecodable.Type {
+			return try cellType.decode(from: self) as! T
+		}
+
+		return try T(from: self)
+	}
+
+	func decodeCell<T: CellDecodable>(_ type: T.Type) throws -> T {
+		if case .null = self.cell {
+			throw DecodingError.valueNotFound(
+				type,
+				DecodingError.Context(codingPath: self.codingPath, debugDescription: "The value is null.")
+			)
+		}
+
+		guard let value = T(cell: self.cell) else {
+			throw DecodingError.typeMismatch(
+				type,
+				DecodingError.Context(
+					codingPath: self.codingPath,
+					debugDescription: "Cannot decode \(type) from \(self.cell)."
+				)
+			)
+		}
+
+		return value
+	}
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+public extension Result {
+	/// Iterates the remaining rows, fetching up to `batchSize` of them at once:
+	///
+	/// ```swift
+	/// var rows = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"users\";").rows()
+	///
+	/// while let row = try rows.next() {
+	/// 	print(row[0].int, row["name"]?.string)
+	/// }
+	/// ```
+	///
+	/// The rows are fetched a batch at a time, like ``Result/fetchBatch(maxRows:)`` does, and read from that batch
+	/// without calling into the driver again. The rows can only be iterated once, as the `Result` moves forward with
+	/// them.
+	func rows(batchSize: Int = 1000) -> RowIterator {
+		RowIterator(result: self, batchSize: batchSize)
+	}
+
+	/// Iterates the rows of a ``Result``.
+	///
+	/// This is not a `Sequence`, as a `for`-`in` loop could not throw the errors of fetching the rows.
+	struct RowIterator {
+		let result: Result
+		let batchSize: Int
+
+		private var plan: ColumnPlan?
+		private var batch: Batch?
+		private var row = 0
+
+		init(result: Result, batchSize: Int) {
+			self.result = result
+			self.batchSize = max(batchSize, 1)
+		}
+
+		/// The next row, or `nil` at the end of the result.
+		/// - Throws: ``ODBCError``.
+		public mutating func next() throws -> Row? {
+			if let batch = self.batch, self.row + 1 < batch.rowCount {
+				self.row += 1
+				return Row(batch: batch, plan: self.plan!, index: self.row)
+			}
+
+			if self.plan == nil {
+				self.plan = try self.result.columnPlan
+			}
+
+			guard let batch = try self.result.fetchBatch(maxRows: self.batchSize) else {
+				self.batch = nil
+				return nil
+			}
+
+			self.batch = batch
+			self.row = 0
+
+			return Row(batch: batch, plan: self.plan!, index: 0)
+		}
+	}
+
+	/// A row of a ``Result``, read from a copy of the batch of rows it was fetched with.
+	///
+	/// Reading a value does not call into the driver, so a `Row` stays valid after the `Result` has moved on.
+	struct Row {
+		let batch: Batch
+		let plan: ColumnPlan
+		let index: Int
+
+		/// The amount of columns in this row.
+		public var count: Int {
+			self.batch.columns.count
+		}
+
+		/// The value in the column at `index`.
+		public subscript(index: Int) -> Field {
+			Field(cell: self.batch.columns[index].cell(at: self.index))
+		}
+
+		/// The value in the column called `name`, or `nil` if there is no such column. A name that matches no column
+		/// exactly matches the only column whose name differs from it in case.
+		public subscript(name: String) -> Field? {
+			self.plan.column(named: name).map { self[$0] }
+		}
+
+		/// Decodes this row as a `T`, like ``Result/decode(_:)``.
+		/// - Throws: ``ODBCError``, or `DecodingError` if a value does not match the property it is decoded as.
+		public func decode<T: Decodable>(_ type: T.Type = T.self) throws -> T {
+			try RowDecoder(plan: self.plan) { column in self.batch.columns[column].cell(at: self.index) }.decode(type)
+		}
+	}
+
+	/// A value of a ``Result/Row``.
+	///
+	/// Each accessor converts the value where no precision is lost, like ``Result/decode(_:)`` does, and returns
+	/// `nil` if the value is `null` or cannot be converted.
+	struct Field {
+		let cell: Cell
+
+		/// If the value is `null`.
+		public var isNull: Bool {
+			if case .null = self.cell { return true }
+			return false
+		}
+
+		public var int: Int? { Int(cell: self.cell) }
+		public var int64: Int64? { Int64(cell: self.cell) }
+		public var double: Double? { Double(cell: self.cell) }
+		public var float: Float? { Float(cell: self.cell) }
+		public var bool: Bool? { Bool(cell: self.cell) }
+		public var string: String? { String(cell: self.cell) }
+		public var bytes: [UInt8]? { [UInt8](cell: self.cell) }
+		public var date: ODBCDate? { ODBCDate(cell: self.cell) }
+		public var time: ODBCTime? { ODBCTime(cell: self.cell) }
+		public var timeStamp: ODBCTimeStamp? { ODBCTimeStamp(cell: self.cell) }
+
+		public var decimal: ODBCDecimal? {
+			switch self.cell {
+				case let .int64(value): return ODBCDecimal(significand: value, scale: 0)
+				case let .string(value): return ODBCDecimal(value)
+				default: return nil
+			}
+		}
+	}
+}
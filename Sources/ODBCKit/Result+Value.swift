@@ -5,11 +5,21 @@
 //  The full text of the license can be found in the file named LICENSE.
 
 import CNanODBC
+#if canImport(Darwin)
+	import Darwin
+#elseif canImport(Glibc)
+	import Glibc
+#endif
 
 public extension Result {
 	struct Value: CustomStringConvertible, CustomDebugStringConvertible {
 		let numOrName: ODBCEither<Int16, String>
-		let resPointer: OpaquePointer
+		/// Keeps the result alive, so that the value can still be read after the `Result` has been deinitialized.
+		let handle: Handle
+
+		var resPointer: OpaquePointer {
+			self.handle.resPointer
+		}
 
 		public var description: String {
 			guard (try? !self.isNull) ?? true else { return "null" }
@@ -18,8 +28,10 @@ public extension Result {
 					return (try? self.string?.description) ?? Optional<String>.none.debugDescription
 				case .integer, .smallInt, .tinyInt, .bigInt:
 					return (try? self.int?.description) ?? Optional<Int>.none.debugDescription
-				case .real, .float, .double, .numeric, .decimal:
+				case .real, .float, .double:
 					return (try? self.double?.description) ?? Optional<Double>.none.debugDescription
+				case .numeric, .decimal:
+					return (try? self.decimal?.description) ?? Optional<ODBCDecimal>.none.debugDescription
 				case .date:
 					return (try? self.date?.debugDescription) ?? Optional<ODBCDate>.none.debugDescription
 				case .time:
@@ -52,6 +64,10 @@ public extension Result {
 				if errorPointer.pointee.isValid {
 					throw ODBCError.fromErrorPointer(errorPointer)
 				} else {
+					defer {
+						free(UnsafeMutablePointer(mutating: res))
+					}
+
 					return String(cString: res)
 				}
 			}
@@ -282,6 +298,34 @@ public extension Result {
 			}
 		}
 
+		/// Retrieves an exact ``ODBCDecimal`` from this ``ResultValue``, without the rounding of ``double``.
+		/// - Throws: ``ODBCError``.
+		public var decimal: ODBCDecimal? {
+			get throws {
+				let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+				let res: CDecimal
+
+				switch self.numOrName {
+					case var .left(index):
+						res = resultGetDecimal(self.resPointer, &index, nil, errorPointer)
+					case let .right(name):
+						res = resultGetDecimal(self.resPointer, nil, name, errorPointer)
+				}
+
+				if errorPointer.pointee.isValid {
+					let error = ODBCError.fromErrorPointer(errorPointer)
+
+					if case .nullAccessError = error {
+						return nil
+					} else {
+						throw error
+					}
+				} else {
+					return ODBCDecimal(cDecimal: res)
+				}
+			}
+		}
+
 		/// Retrieves an `Bool` from this ``ResultValue``.
 		/// - Throws: ``ODBCError``.
 		public var bool: Bool? {
@@ -316,12 +360,21 @@ public extension Result {
 			get throws {
 				let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
 				var res: UnsafePointer<CChar>?
+				var length: UInt = 0
+				let isBorrowed: Bool
 
+				// Read bound character data in place, and only fall back to a copy for other columns.
 				switch self.numOrName {
 					case var .left(index):
-						res = resultGetString(self.resPointer, &index, nil, errorPointer)
+						isBorrowed = resultGetStringView(self.resPointer, &index, nil, &res, &length, errorPointer)
+						if !isBorrowed, !errorPointer.pointee.isValid {
+							res = resultGetString(self.resPointer, &index, nil, errorPointer)
+						}
 					case let .right(name):
-						res = resultGetString(self.resPointer, nil, name, errorPointer)
+						isBorrowed = resultGetStringView(self.resPointer, nil, name, &res, &length, errorPointer)
+						if !isBorrowed, !errorPointer.pointee.isValid {
+							res = resultGetString(self.resPointer, nil, name, errorPointer)
+						}
 				}
 
 				if errorPointer.pointee.isValid {
@@ -333,9 +386,17 @@ public extension Result {
 						throw error
 					}
 				} else {
-					if let cString = res {
-						return String(cString: cString)
-					} else { return nil }
+					guard let cString = res else { return nil }
+
+					if isBorrowed {
+						return String(decoding: UnsafeRawBufferPointer(start: cString, count: Int(length)), as: UTF8.self)
+					}
+
+					defer {
+						free(UnsafeMutablePointer(mutating: cString))
+					}
+
+					return String(cString: cString)
 				}
 			}
 		}
@@ -345,16 +406,18 @@ public extension Result {
 		public var time: ODBCTime? {
 			get throws {
 				let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
-				var res: UnsafeMutablePointer<CTime>?
+
+				var value = CTime()
+				let succeeded: Bool
 
 				switch self.numOrName {
 					case var .left(index):
-						res = resultGetTime(self.resPointer, &index, nil, errorPointer)
+						succeeded = resultGetTimeInto(self.resPointer, &index, nil, &value, errorPointer)
 					case let .right(name):
-						res = resultGetTime(self.resPointer, nil, name, errorPointer)
+						succeeded = resultGetTimeInto(self.resPointer, nil, name, &value, errorPointer)
 				}
 
-				if errorPointer.pointee.isValid {
+				guard succeeded else {
 					let error = ODBCError.fromErrorPointer(errorPointer)
 
 					if case .nullAccessError = error {
@@ -362,11 +425,9 @@ public extension Result {
 					} else {
 						throw error
 					}
-				} else {
-					if let cTime = res {
-						return ODBCTime(cTime: cTime.pointee)
-					} else { return nil }
 				}
+
+				return ODBCTime(cTime: value)
 			}
 		}
 
@@ -375,16 +436,18 @@ public extension Result {
 		public var date: ODBCDate? {
 			get throws {
 				let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
-				var res: UnsafeMutablePointer<CDate>?
+
+				var value = CDate()
+				let succeeded: Bool
 
 				switch self.numOrName {
 					case var .left(index):
-						res = resultGetDate(self.resPointer, &index, nil, errorPointer)
+						succeeded = resultGetDateInto(self.resPointer, &index, nil, &value, errorPointer)
 					case let .right(name):
-						res = resultGetDate(self.resPointer, nil, name, errorPointer)
+						succeeded = resultGetDateInto(self.resPointer, nil, name, &value, errorPointer)
 				}
 
-				if errorPointer.pointee.isValid {
+				guard succeeded else {
 					let error = ODBCError.fromErrorPointer(errorPointer)
 
 					if case .nullAccessError = error {
@@ -392,11 +455,9 @@ public extension Result {
 					} else {
 						throw error
 					}
-				} else {
-					if let cDate = res {
-						return ODBCDate(cDate: cDate.pointee)
-					} else { return nil }
 				}
+
+				return ODBCDate(cDate: value)
 			}
 		}
 
@@ -405,16 +466,18 @@ public extension Result {
 		public var timeStamp: ODBCTimeStamp? {
 			get throws {
 				let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
-				var res: UnsafeMutablePointer<CTimeStamp>?
+
+				var value = CTimeStamp()
+				let succeeded: Bool
 
 				switch self.numOrName {
 					case var .left(index):
-						res = resultGetTimeStamp(self.resPointer, &index, nil, errorPointer)
+						succeeded = resultGetTimeStampInto(self.resPointer, &index, nil, &value, errorPointer)
 					case let .right(name):
-						res = resultGetTimeStamp(self.resPointer, nil, name, errorPointer)
+						succeeded = resultGetTimeStampInto(self.resPointer, nil, name, &value, errorPointer)
 				}
 
-				if errorPointer.pointee.isValid {
+				guard succeeded else {
 					let error = ODBCError.fromErrorPointer(errorPointer)
 
 					if case .nullAccessError = error {
@@ -422,11 +485,9 @@ public extension Result {
 					} else {
 						throw error
 					}
-				} else {
-					if let cTimeStamp = res {
-						return ODBCTimeStamp(cTimeStamp: cTimeStamp.pointee)
-					} else { return nil }
 				}
+
+				return ODBCTimeStamp(cTimeStamp: value)
 			}
 		}
 
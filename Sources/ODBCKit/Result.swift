@@ -7,8 +7,54 @@
 import CNanODBC
 
 /// The result of running a query.
+///
+/// Copies of a `Result` share the same rows. They are freed, and the statement and connection the query ran on can be
+/// reused or closed, once the last copy, and every ``Result/Value`` read from it, have been deinitialized.
 public struct Result {
-	let resPointer: OpaquePointer
+	let handle: Handle
+
+	var resPointer: OpaquePointer {
+		self.handle.resPointer
+	}
+
+	/// The `Statement` or `Connection` this `Result` was produced by.
+	var owner: AnyObject? {
+		self.handle.owner
+	}
+
+	init(resPointer: OpaquePointer, owner: AnyObject?) {
+		self.handle = Handle(resPointer: resPointer, owner: owner)
+	}
+
+	/// Owns the C result, which is destroyed along with the last `Result` or ``Result/Value`` that refers to it.
+	final class Handle {
+		let resPointer: OpaquePointer
+
+		/// Kept so that the statement or connection is not reused (by the statement cache or a ``ConnectionPool``)
+		/// while the result is alive. It is released after the result has been destroyed.
+		let owner: AnyObject?
+
+		/// The columns of the current result set, resolved by the first decode and dropped by
+		/// ``Result/nextResultSet()``.
+		var plan: ColumnPlan?
+
+		/// The storage ``Result/fetchBatch(maxRows:)`` refills for every batch, so that fetching batch after batch
+		/// reuses the buffers of the previous one instead of allocating them again.
+		var batch: UnsafeMutablePointer<CBatch>?
+
+		init(resPointer: OpaquePointer, owner: AnyObject?) {
+			self.resPointer = resPointer
+			self.owner = owner
+		}
+
+		deinit {
+			if let batch = self.batch {
+				batchDestroy(batch)
+			}
+
+			resultDestroy(self.resPointer)
+		}
+	}
 
 	/// The amount of affected rows.
 	/// - Throws: ``ODBCError``.
@@ -155,6 +201,36 @@ public struct Result {
 		}
 	}
 
+	/// Moves to the next result set of a query that returns several, like a batch of `SELECT` statements or a stored
+	/// procedure, so that all of them arrive in a single exchange with the database.
+	///
+	/// ```swift
+	/// let res = try conn.execute(query: "SELECT * FROM \"users\"; SELECT * FROM \"groups\";")
+	///
+	/// repeat {
+	/// 	while try res.next() {
+	/// 		...
+	/// 	}
+	/// } while try res.nextResultSet()
+	/// ```
+	///
+	/// The `Result` is placed before the first row of the new result set, so call ``next()`` to read it.
+	///
+	/// - Throws: `ODBCError`.
+	/// - Returns: `true` if there was another result set, `false` otherwise.
+	public func nextResultSet() throws -> Bool {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let res = resultNextResult(resPointer, errorPointer)
+		self.handle.plan = nil
+
+		if errorPointer.pointee.isValid {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		} else {
+			return res
+		}
+	}
+
 	/// Finds the index of the named column in the currently selected row.
 	public func index(of column: String) throws -> Int {
 		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
@@ -185,13 +261,13 @@ public struct Result {
 
 	public subscript(index: Int) -> Self.Value? {
 		mutating get {
-			Self.Value(numOrName: .left(Int16(index)), resPointer: self.resPointer)
+			Self.Value(numOrName: .left(Int16(index)), handle: self.handle)
 		}
 	}
 
 	public subscript(name: String) -> Self.Value? {
 		mutating get {
-			Self.Value(numOrName: .right(name), resPointer: self.resPointer)
+			Self.Value(numOrName: .right(name), handle: self.handle)
 		}
 	}
 }
@@ -14,7 +14,17 @@ public class Statement {
 
 	let statementPointer: OpaquePointer
 
+	/// Kept so that the connection outlives this statement, which returns to its cache when deinitialized.
+	let connection: Connection
+
+	/// The numeric arrays ``executeBatch(rows:timeout:)`` binds in place. The statement stays bound to them after the
+	/// execution, while a `Result` retains it and until the next execution, so they live as long as the statement.
+	let parameterBuffers = ParameterBuffers()
+
+	/// Creates a `Statement` for `query`, reusing one already prepared with the same `timeout` from the connection's
+	/// statement cache if possible.
 	public init(connection: Connection, query: String, timeout: Int = 0) {
+		self.connection = connection
 		self.statementPointer = stmtCreate(connection.connection, query, timeout)
 	}
 
@@ -28,16 +38,23 @@ public class Statement {
 	}
 
 	/// Executes this `Statement` and returns the `Result` of execution.
-	/// - Parameter values: The values to bind to the `?` parameters in your query.
+	/// - Parameters:
+	///   - values: The values to bind to the `?` parameters in your query.
+	///   - rowsetSize: The amount of rows fetched from the driver at once.
+	///   - timeout: The amount of seconds to wait for the query to execute. 0 means no timeout.
 	/// - Throws: `ODBCError`.
 	/// - Returns: `Result`.
-	public func execute<B: BindableValue>(with values: [B?] = [], timeout: Int = 0) throws -> Result {
+	public func execute<B: BindableValue>(
+		with values: [B?] = [],
+		rowsetSize: Int = 1,
+		timeout: Int = 0
+	) throws -> Result {
 		for i in 0..<values.count {
 			try values[i].bind(stmtPointer: self.statementPointer, index: Int16(i))
 		}
 
 		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
-		let resPointer = stmtExecute(statementPointer, timeout, errorPointer)
+		let resPointer = stmtExecute(statementPointer, rowsetSize, timeout, errorPointer)
 
 		if errorPointer.pointee.isValid {
 			throw ODBCError.fromErrorPointer(errorPointer)
@@ -45,10 +62,193 @@ public class Statement {
 
 		guard let res = resPointer else { throw ODBCError.unexpectedNull(name: "nanodbc::statement::execute") }
 
-		return Result(resPointer: res)
+		return Result(resPointer: res, owner: self)
+	}
+
+	/// Executes this `Statement` once for every row in `rows`, sending all of them to the driver in a single execution.
+	///
+	/// The values are bound column by column, so all values in a column must be integers (including `Bool`), floating
+	/// point numbers, `String`s or ``ODBCDecimal``s, or `[UInt8]`s. `nil` values are bound as `NULL`.
+	///
+	/// - Parameters:
+	///   - rows: The values to bind to the `?` parameters in your query, one array per row.
+	///   - timeout: The amount of seconds to wait for the query to execute. 0 means no timeout.
+	/// - Throws: `ODBCError`.
+	/// - Returns: `Result`.
+	public func executeBatch(rows: [[BindableValue?]], timeout: Int = 0) throws -> Result {
+		try self.executeBatch(rows: rows, timeout: timeout, statuses: nil)
+	}
+
+	/// Like ``executeBatch(rows:timeout:)``, writing the outcome of each row to `statuses`, if given, which must have
+	/// room for `rows.count` statuses.
+	func executeBatch(
+		rows: [[BindableValue?]],
+		timeout: Int,
+		statuses: UnsafeMutablePointer<ParameterRowStatus>?
+	) throws -> Result {
+		guard let columnCount = rows.first?.count, rows.allSatisfy({ $0.count == columnCount }) else {
+			throw ODBCError.programmingError(message: "executeBatch requires rows of equal length")
+		}
+
+		for column in 0..<columnCount {
+			try self.bindColumn(rows.map { $0[column] }, to: Int16(column))
+		}
+
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+		let resPointer: OpaquePointer?
+
+		if let statuses = statuses {
+			resPointer = stmtExecuteBatchWithStatus(statementPointer, rows.count, timeout, statuses, errorPointer)
+		} else {
+			resPointer = stmtExecuteBatch(statementPointer, rows.count, timeout, errorPointer)
+		}
+
+		if errorPointer.pointee.isValid {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+
+		guard let res = resPointer else { throw ODBCError.unexpectedNull(name: "nanodbc::statement::execute") }
+
+		return Result(resPointer: res, owner: self)
+	}
+
+	private func bindColumn(_ values: [BindableValue?], to index: Int16) throws {
+		let nulls = values.map { $0 == nil }
+		let errorPointer: UnsafeMutablePointer<CError>?
+
+		switch values.lazy.compactMap({ $0 }).first?.type {
+			case .int, .int16, .int32, .int64, .uint16, .bool:
+				let buffer = self.parameterBuffers.buffer(for: index, count: values.count, of: Int64.self)
+
+				for (i, value) in values.enumerated() {
+					buffer[i] = try Self.int64(value)
+				}
+
+				errorPointer = stmtBindBigIntArray(
+					self.statementPointer, index, buffer.baseAddress!, values.count, nulls
+				)
+			case .float, .double:
+				let buffer = self.parameterBuffers.buffer(for: index, count: values.count, of: Double.self)
+
+				for (i, value) in values.enumerated() {
+					buffer[i] = try Self.double(value)
+				}
+
+				errorPointer = stmtBindDoubleArray(
+					self.statementPointer, index, buffer.baseAddress!, values.count, nulls
+				)
+			case .string, .decimal:
+				// All strings are stored in one buffer, which the C side copies before returning.
+				var characters: [CChar] = []
+				var offsets: [Int?] = []
+
+				for value in values {
+					switch value {
+						case nil: offsets.append(nil)
+						case let string as String:
+							offsets.append(characters.count)
+							characters.append(contentsOf: string.utf8CString)
+						case let decimal as ODBCDecimal:
+							offsets.append(characters.count)
+							characters.append(contentsOf: decimal.description.utf8CString)
+						default: throw ODBCError.invalidType(message: "Expected a String, got \(value!)")
+					}
+				}
+
+				errorPointer = characters.withUnsafeBufferPointer { buffer in
+					let strings = offsets.map { $0.map { buffer.baseAddress! + $0 } }
+					return stmtBindStringArray(self.statementPointer, index, strings, values.count, nil)
+				}
+			case .bytes:
+				var bytes: [UInt8] = []
+				var offsets: [Int?] = []
+				var sizes: [Int64] = []
+
+				for value in values {
+					switch value {
+						case nil:
+							offsets.append(nil)
+							sizes.append(0)
+						case let array as [UInt8]:
+							offsets.append(bytes.count)
+							sizes.append(Int64(array.count))
+							bytes.append(contentsOf: array)
+						default: throw ODBCError.invalidType(message: "Expected [UInt8], got \(value!)")
+					}
+				}
+
+				// Keeps the base address non-nil when every value is empty.
+				bytes.append(0)
+
+				errorPointer = bytes.withUnsafeBufferPointer { buffer in
+					let arrays = offsets.map { $0.map { buffer.baseAddress! + $0 } }
+					return stmtBindBinaryArray(self.statementPointer, index, arrays, sizes, values.count, nil)
+				}
+			case .none, .nil:
+				errorPointer = stmtBindNullArray(self.statementPointer, index, values.count)
+			case let .some(type):
+				throw ODBCError.invalidType(message: "executeBatch does not support \(type) values")
+		}
+
+		if let errorPointer = errorPointer {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
 	}
 
-//	deinit {
-//		stmtClose(statementPointer)
-//	}
+	private static func int64(_ value: BindableValue?) throws -> Int64 {
+		switch value {
+			case nil: return 0
+			case let v as Int: return Int64(v)
+			case let v as Int16: return Int64(v)
+			case let v as Int32: return Int64(v)
+			case let v as Int64: return v
+			case let v as UInt16: return Int64(v)
+			case let v as Bool: return v ? 1 : 0
+			default: throw ODBCError.invalidType(message: "Expected an integer, got \(value!)")
+		}
+	}
+
+	private static func double(_ value: BindableValue?) throws -> Double {
+		switch value {
+			case nil: return 0
+			case let v as Float: return Double(v)
+			case let v as Double: return v
+			default: throw ODBCError.invalidType(message: "Expected a floating point number, got \(value!)")
+		}
+	}
+
+	deinit {
+		stmtDestroy(statementPointer)
+	}
+}
+
+/// The arrays of numeric parameter values that ``Statement/executeBatch(rows:timeout:)`` binds in place, and which
+/// must therefore outlive the execution; see ``Statement/parameterBuffers``. Each column's buffer is kept and reused
+/// by later executions that fit into it.
+final class ParameterBuffers {
+	private var buffers: [Int16: UnsafeMutableRawBufferPointer] = [:]
+
+	deinit {
+		self.buffers.values.forEach { $0.deallocate() }
+	}
+
+	func buffer<T>(for column: Int16, count: Int, of type: T.Type) -> UnsafeMutableBufferPointer<T> {
+		let byteCount = max(count, 1) * MemoryLayout<T>.stride
+
+		if let buffer = self.buffers[column], buffer.count >= byteCount {
+			return UnsafeMutableBufferPointer(rebasing: buffer.bindMemory(to: T.self)[..<count])
+		}
+
+		let previous = self.buffers.removeValue(forKey: column)
+		previous?.deallocate()
+
+		// Grow in steps, so that batches of slowly increasing size do not reallocate every time.
+		let buffer = UnsafeMutableRawBufferPointer.allocate(
+			byteCount: max(byteCount, (previous?.count ?? 0) * 2),
+			alignment: MemoryLayout<Int64>.alignment
+		)
+		self.buffers[column] = buffer
+
+		return UnsafeMutableBufferPointer(rebasing: buffer.bindMemory(to: T.self)[..<count])
+	}
 }
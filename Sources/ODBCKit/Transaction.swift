@@ -0,0 +1,163 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+
+/// A transaction on a ``Connection``, begun with ``Connection/beginTransaction()``.
+///
+/// Transactions on the same connection nest: only the outermost transaction commits on the database, and rolling back
+/// an inner one rolls back the outermost one as well. A transaction that is deinitialized without having been
+/// committed is rolled back.
+public final class Transaction {
+	let transactionPointer: OpaquePointer
+
+	/// Kept so that the connection outlives this transaction.
+	public let connection: Connection
+
+	init(connection: Connection) throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		guard let t = transactionBegin(connection.connection, errorPointer) else {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+
+		self.transactionPointer = t
+		self.connection = connection
+	}
+
+	deinit {
+		transactionDestroy(self.transactionPointer)
+	}
+
+	/// Commits the transaction.
+	/// - Throws: ``ODBCError``, also if this or a nested transaction has been rolled back.
+	public func commit() throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		if !transactionCommit(self.transactionPointer, errorPointer) {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+	}
+
+	/// Marks the transaction for rollback, which happens once the outermost transaction ends.
+	public func rollback() {
+		transactionRollback(self.transactionPointer)
+	}
+}
+
+/// Runs statements in a transaction that is committed every few statements or milliseconds, created with
+/// ``Connection/batchingCommits(every:orMilliseconds:)``.
+///
+/// Committing in batches spares the database a commit, and usually a flush to disk, per statement, while keeping
+/// transactions short. Statements since the last commit are rolled back if the `CommitBatcher` is deinitialized
+/// without ``finish()`` having been called.
+public final class CommitBatcher {
+	let batcherPointer: OpaquePointer
+
+	/// Kept so that the connection outlives the transaction.
+	public let connection: Connection
+
+	init(connection: Connection, statements: Int, milliseconds: Int) throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		guard let b = commitBatcherCreate(connection.connection, statements, milliseconds, errorPointer) else {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+
+		self.batcherPointer = b
+		self.connection = connection
+	}
+
+	deinit {
+		commitBatcherDestroy(self.batcherPointer)
+	}
+
+	/// Executes `query` like ``Connection/justExecute(query:timeout:)`` and counts it towards the next commit.
+	/// - Throws: ``ODBCError``.
+	public func execute(query: String, timeout: Int = 0) throws {
+		try self.connection.justExecute(query: query, timeout: timeout)
+		try self.didExecute()
+	}
+
+	/// Counts `statements` statements that have been executed on the connection towards the next commit, committing
+	/// if a limit has been reached.
+	/// - Throws: ``ODBCError``.
+	/// - Returns: `true` if the statements have been committed.
+	@discardableResult
+	public func didExecute(statements: Int = 1) throws -> Bool {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+		let committed = commitBatcherCount(self.batcherPointer, statements, errorPointer)
+
+		if errorPointer.pointee.isValid {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+
+		return committed
+	}
+
+	/// Commits the statements executed since the last commit.
+	/// - Throws: ``ODBCError``.
+	public func flush() throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		if !commitBatcherFlush(self.batcherPointer, errorPointer) {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+	}
+
+	/// Commits the remaining statements and ends the transaction.
+	/// - Throws: ``ODBCError``.
+	public func finish() throws {
+		let errorPointer = UnsafeMutablePointer<CError>.cErrorPointer
+
+		if !commitBatcherFinish(self.batcherPointer, errorPointer) {
+			throw ODBCError.fromErrorPointer(errorPointer)
+		}
+	}
+}
+
+public extension Connection {
+	/// Begins a transaction, turning autocommit off until the outermost transaction on this connection ends.
+	/// - Throws: ``ODBCError``.
+	func beginTransaction() throws -> Transaction {
+		try Transaction(connection: self)
+	}
+
+	/// Runs `body` in a transaction that is committed if `body` returns and rolled back if it throws.
+	/// - Throws: ``ODBCError``, or whatever `body` throws.
+	func withTransaction<T>(_ body: (Connection) throws -> T) throws -> T {
+		let transaction = try self.beginTransaction()
+
+		do {
+			let value = try body(self)
+			try transaction.commit()
+			return value
+		} catch {
+			transaction.rollback()
+			throw error
+		}
+	}
+
+	/// Begins a transaction that is committed every `statements` statements or after `milliseconds`, whichever comes
+	/// first. Pass 0 to turn either limit off.
+	///
+	/// ```swift
+	/// let batcher = try conn.batchingCommits(every: 500, orMilliseconds: 1000)
+	///
+	/// for row in rows {
+	/// 	try batcher.execute(query: insert(row))
+	/// }
+	///
+	/// try batcher.finish()
+	/// ```
+	///
+	/// Inside an enclosing transaction, the statements are only committed along with it.
+	///
+	/// - Throws: ``ODBCError``.
+	func batchingCommits(every statements: Int, orMilliseconds milliseconds: Int = 0) throws -> CommitBatcher {
+		try CommitBatcher(connection: self, statements: statements, milliseconds: milliseconds)
+	}
+}
@@ -7,10 +7,10 @@
 import CNanODBC
 
 extension UnsafeMutablePointer where Self.Pointee == CError {
+	/// The calling thread's error record, cleared. Reused by every call on the thread, so it must be checked right
+	/// after the call it was passed to, and must not be deallocated.
 	static var cErrorPointer: UnsafeMutablePointer<CError> {
-		let p = UnsafeMutablePointer<CError>.allocate(capacity: 1)
-		p.pointee.isValid = false
-		return p
+		threadError()
 	}
 }
 
@@ -0,0 +1,364 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+import Dispatch
+import Foundation
+import ODBCKit
+
+// Measures the overhead of fetching, binding and bridging values through ODBCKit, using the SQLite ODBC driver on
+// a temporary database.
+//
+// Usage: ODBCKitBenchmarks [--rows N] [--iterations N] [--filter SUBSTRING]
+//
+// Every benchmark prints one JSON object per line to standard output:
+//
+//     {"name":"fetch/index/int","rows":100000,"seconds":0.0421,"rowsPerSecond":2375296}
+//
+// `seconds` is the fastest of all iterations.
+
+struct Options {
+	var rows = 100_000
+	var iterations = 3
+	var filter: String?
+
+	init(arguments: [String]) {
+		var iterator = arguments.dropFirst().makeIterator()
+
+		while let argument = iterator.next() {
+			switch argument {
+				case "--rows": self.rows = iterator.next().flatMap(Int.init) ?? self.rows
+				case "--iterations": self.iterations = iterator.next().flatMap(Int.init) ?? self.iterations
+				case "--filter": self.filter = iterator.next()
+				default:
+					FileHandle.standardError.write("Unknown argument \(argument)\n".data(using: .utf8)!)
+					exit(2)
+			}
+		}
+	}
+}
+
+let options = Options(arguments: CommandLine.arguments)
+let dbPath = NSTemporaryDirectory() + "odbckit-benchmarks-\(ProcessInfo.processInfo.processIdentifier).db"
+let connString = "Driver={SQLite3};Database=\(dbPath);"
+
+FileManager.default.createFile(atPath: dbPath, contents: nil, attributes: nil)
+
+/// Runs `body`, which processes and returns an amount of rows, `options.iterations` times and prints the fastest run.
+func benchmark(_ name: String, _ body: () throws -> Int) throws {
+	if let filter = options.filter, !name.contains(filter) { return }
+
+	var best = Double.infinity
+	var rows = 0
+
+	for _ in 0..<max(options.iterations, 1) {
+		let start = DispatchTime.now().uptimeNanoseconds
+		rows = try body()
+		let seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+		best = min(best, seconds)
+	}
+
+	print(#"{"name":"\#(name)","rows":\#(rows),"seconds":\#(best),"rowsPerSecond":\#(Int(Double(rows) / best))}"#)
+}
+
+func fetch(
+	_ conn: Connection,
+	_ query: String,
+	rowsetSize: Int = 1,
+	_ read: (inout ODBCKit.Result) throws -> Void
+) throws -> Int {
+	var res = try conn.execute(query: query, rowsetSize: rowsetSize)
+	var rows = 0
+
+	while try res.next() {
+		try read(&res)
+		rows += 1
+	}
+
+	return rows
+}
+
+let conn = try Connection(.odbcString(connString))
+
+try conn.justExecute(query: """
+DROP TABLE IF EXISTS "bench";
+CREATE TABLE "bench" ("id" INTEGER NOT NULL, "i" INTEGER NOT NULL, "d" REAL NOT NULL, "s" VARCHAR(64) NOT NULL);
+DROP TABLE IF EXISTS "benchInsert";
+CREATE TABLE "benchInsert" ("id" INTEGER NOT NULL, "s" VARCHAR(64));
+""")
+
+do {
+	let insert = conn.statement(query: "INSERT INTO \"bench\" (\"id\", \"i\", \"d\", \"s\") VALUES (?, ?, ?, ?);")
+
+	for start in stride(from: 0, to: options.rows, by: 1000) {
+		let rows: [[BindableValue?]] = (start..<min(start + 1000, options.rows)).map { id in
+			[id, id * 7, Double(id) / 3, "row number \(id)"]
+		}
+
+		_ = try insert.executeBatch(rows: rows)
+	}
+}
+
+let selectAll = "SELECT \"id\", \"i\", \"d\", \"s\" FROM \"bench\";"
+
+// MARK: - Fetching
+
+try benchmark("fetch/next") {
+	try fetch(conn, selectAll) { _ in }
+}
+
+try benchmark("fetch/index/int") {
+	try fetch(conn, selectAll) { res in _ = try res[1]!.int }
+}
+
+try benchmark("fetch/index/double") {
+	try fetch(conn, selectAll) { res in _ = try res[2]!.double }
+}
+
+try benchmark("fetch/index/string") {
+	try fetch(conn, selectAll) { res in _ = try res[3]!.string }
+}
+
+try benchmark("fetch/name/int") {
+	try fetch(conn, selectAll) { res in _ = try res["i"]!.int }
+}
+
+try benchmark("fetch/name/string") {
+	try fetch(conn, selectAll) { res in _ = try res["s"]!.string }
+}
+
+try benchmark("fetch/columnRef/int") {
+	var res = try conn.execute(query: selectAll)
+	let column = try res.column(named: "i")
+	var rows = 0
+
+	while try res.next() {
+		_ = try res[column]!.int
+		rows += 1
+	}
+
+	return rows
+}
+
+try benchmark("fetch/rowset/all") {
+	try fetch(conn, selectAll, rowsetSize: 1000) { res in
+		_ = try res[0]!.int
+		_ = try res[1]!.int
+		_ = try res[2]!.double
+		_ = try res[3]!.string
+	}
+}
+
+try benchmark("fetch/batch/all") {
+	let res = try conn.execute(query: selectAll, rowsetSize: 1000)
+	var rows = 0
+
+	while let batch = try res.fetchBatch(maxRows: 1000) {
+		rows += batch.rowCount
+	}
+
+	return rows
+}
+
+try benchmark("fetch/batch/prefetch") {
+	let res = try conn.execute(query: selectAll, rowsetSize: 1000)
+	let batches = try res.prefetchBatches(maxRows: 1000)
+	var rows = 0
+
+	while let batch = try batches.next() {
+		rows += batch.rowCount
+	}
+
+	return rows
+}
+
+try benchmark("fetch/rows/all") {
+	var rows = 0
+	var iterator = try conn.execute(query: selectAll, rowsetSize: 1000).rows()
+
+	while let row = try iterator.next() {
+		_ = row[0].int
+		_ = row[1].int
+		_ = row[2].double
+		_ = row[3].string
+		rows += 1
+	}
+
+	return rows
+}
+
+// Null values are reported through the error channel, so this measures its failure path.
+try benchmark("fetch/index/null") {
+	try fetch(conn, "SELECT NULL AS \"n\" FROM \"bench\";") { res in _ = try res[0]!.int }
+}
+
+// MARK: - Error reporting
+
+// The cost of the error channel every getter goes through, without the getter itself: a `CError` allocated and
+// freed for each call, as before the thread's error record was reused, against the calling thread's record. The
+// `error/getter/` benchmarks below measure the same two channels as part of a whole getter call.
+try benchmark("error/channel/heap") {
+	var failures = 0
+
+	for _ in 0..<options.rows {
+		let error = UnsafeMutablePointer<CError>.allocate(capacity: 1)
+		error.pointee.isValid = false
+		failures += error.pointee.isValid ? 1 : 0
+		error.deallocate()
+	}
+
+	return options.rows - failures
+}
+
+try benchmark("error/channel/thread") {
+	var failures = 0
+
+	for _ in 0..<options.rows {
+		failures += threadError().pointee.isValid ? 1 : 0
+	}
+
+	return options.rows - failures
+}
+
+struct SetupError: Error {
+	let message: String
+
+	init(_ error: UnsafeMutablePointer<CError>) {
+		self.message = error.pointee.message.map { String(cString: $0) } ?? "unknown error"
+	}
+}
+
+/// Reads the integer column of every row with `resultGetInt`, reporting into a `CError` allocated and freed for each
+/// call if `heapErrors` is set, and into the calling thread's record otherwise. The C API is called directly, so that
+/// nothing but the error record differs between the two.
+func readInts(heapErrors: Bool) throws -> Int {
+	let error = threadError()
+
+	guard let rawConn = createConnectionConnectionString(connString, 0, error) else { throw SetupError(error) }
+	defer { destroyConnection(rawConn) }
+
+	guard let rawRes = cExecute(rawConn, selectAll, 1, 1000, 0, error) else { throw SetupError(error) }
+	defer { resultDestroy(rawRes) }
+
+	var column: Int16 = 1
+	var rows = 0
+
+	while resultNext(rawRes, threadError()) {
+		if heapErrors {
+			let error = UnsafeMutablePointer<CError>.allocate(capacity: 1)
+			error.initialize(to: CError())
+			_ = resultGetInt(rawRes, &column, nil, error)
+			error.deallocate()
+		} else {
+			_ = resultGetInt(rawRes, &column, nil, threadError())
+		}
+
+		rows += 1
+	}
+
+	return rows
+}
+
+try benchmark("error/getter/heap") {
+	try readInts(heapErrors: true)
+}
+
+try benchmark("error/getter/thread") {
+	try readInts(heapErrors: false)
+}
+
+// MARK: - Binding
+
+let insertCount = max(options.rows / 10, 1)
+let insertQuery = "INSERT INTO \"benchInsert\" (\"id\", \"s\") VALUES (?, ?);"
+
+try benchmark("bind/single") {
+	try conn.justExecute(query: "DELETE FROM \"benchInsert\";")
+	let stmt = conn.statement(query: insertQuery)
+
+	for id in 0..<insertCount {
+		try stmt.bind(id, to: 0)
+		try stmt.bind("row number \(id)", to: 1)
+		_ = try stmt.execute(with: [Int?]())
+	}
+
+	return insertCount
+}
+
+try benchmark("bind/batch") {
+	try conn.justExecute(query: "DELETE FROM \"benchInsert\";")
+	let stmt = conn.statement(query: insertQuery)
+
+	for start in stride(from: 0, to: insertCount, by: 1000) {
+		_ = try stmt.executeBatch(rows: (start..<min(start + 1000, insertCount)).map { [$0, "row number \($0)"] })
+	}
+
+	return insertCount
+}
+
+// MARK: - Preparing
+
+let prepareCount = max(options.rows / 10, 1)
+
+try benchmark("prepare/uncached") {
+	conn.statementCacheCapacity = 0
+
+	for _ in 0..<prepareCount {
+		_ = conn.statement(query: insertQuery)
+	}
+
+	return prepareCount
+}
+
+try benchmark("prepare/cached") {
+	conn.statementCacheCapacity = 16
+
+	for _ in 0..<prepareCount {
+		_ = conn.statement(query: insertQuery)
+	}
+
+	return prepareCount
+}
+
+// MARK: - Transcoding
+
+// Column values as they would be fetched from `SQL_WVARCHAR` columns, or bound to them: mostly ASCII, and partly not.
+let texts = [
+	("ascii", (0..<options.rows).map { "row number \($0) of the benchmark table" }),
+	("mixed", (0..<options.rows).map { "Zeile Nummer \($0), größer als 東京 und Zürich" }),
+]
+
+let implementations: [(String, TranscodeImplementation)] = [
+	("best", .bestTranscoder), ("scalar", .scalarTranscoder), ("codecvt", .codecvtTranscoder),
+]
+
+for (textName, strings) in texts {
+	let utf16 = strings.map { Array($0.utf16) }
+	let utf8 = strings.map { Array($0.utf8).map(CChar.init(bitPattern:)) }
+	let longest = utf16.map(\.count).max() ?? 0
+	var bytes = [CChar](repeating: 0, count: 3 * longest)
+	var units = [UInt16](repeating: 0, count: 3 * longest)
+
+	for (implementationName, implementation) in implementations {
+		try benchmark("transcode/utf16ToUTF8/\(textName)/\(implementationName)") {
+			for string in utf16 {
+				_ = transcodeUTF16ToUTF8(string, UInt(string.count), &bytes, implementation)
+			}
+
+			return utf16.count
+		}
+
+		try benchmark("transcode/utf8ToUTF16/\(textName)/\(implementationName)") {
+			for string in utf8 {
+				_ = transcodeUTF8ToUTF16(string, UInt(string.count), &units, implementation)
+			}
+
+			return utf8.count
+		}
+	}
+}
+
+try? FileManager.default.removeItem(atPath: dbPath)
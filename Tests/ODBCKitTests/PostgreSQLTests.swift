@@ -69,4 +69,34 @@ final class PostgreSQLTests: XCTestCase {
 		XCTAssertEqual(try res[2]!.int, 23809)
 		XCTAssertNil(try res[9]?.string)
 	}
+
+	func testNextResultSet() throws {
+		let conn = try Connection(Self.connString)
+
+		let res = try conn.execute(query: """
+		SELECT 1 AS "a", 'one'::varchar(8) AS "b";
+		SELECT 2 AS "c", 'two'::varchar(8) AS "d";
+		SELECT 'three'::text AS "e";
+		""")
+
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 1)
+		XCTAssertEqual(try res["b"]!.string, "one")
+
+		// The same column types and sizes, so the buffers of the first result set are reused under the new names.
+		XCTAssertTrue(try res.nextResultSet())
+		XCTAssertEqual(try res.name(of: 0), "c")
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 2)
+		XCTAssertEqual(try res["d"]!.string, "two")
+		XCTAssertFalse(try res.next())
+
+		// Different columns, which are bound anew.
+		XCTAssertTrue(try res.nextResultSet())
+		XCTAssertEqual(try res.columns, 1)
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res["e"]!.string, "three")
+
+		XCTAssertFalse(try res.nextResultSet())
+	}
 }
@@ -4,6 +4,7 @@
 //
 //  The full text of the license can be found in the file named LICENSE.
 
+import CNanODBC
 @testable import ODBCKit
 import XCTest
 
@@ -74,4 +75,786 @@ final class SQLiteTests: XCTestCase {
 		print("TimeStamp: \(try res[7]!.timeStamp!)")
 		print("Bytes: \(try res[8]!.bytes!)")
 	}
+
+	func testRowsetFetch() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "rowsetTable";
+		CREATE TABLE "rowsetTable" ("id" INTEGER NOT NULL);
+		INSERT INTO "rowsetTable" ("id") VALUES (1), (2), (3), (4), (5), (6), (7);
+		""")
+
+		var res = try conn.execute(query: "SELECT \"id\" FROM \"rowsetTable\" ORDER BY \"id\";", rowsetSize: 3)
+		var ids: [Int] = []
+
+		while try res.next() {
+			ids.append(try res[0]!.int!)
+		}
+
+		XCTAssertEqual(ids, [1, 2, 3, 4, 5, 6, 7])
+	}
+
+	func testFetchBatch() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "batchTable";
+		CREATE TABLE "batchTable" ("id" INTEGER NOT NULL, "name" VARCHAR(32));
+		INSERT INTO "batchTable" ("id", "name") VALUES (1, 'one'), (2, NULL), (3, 'three');
+		""")
+
+		let res = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"batchTable\" ORDER BY \"id\";", rowsetSize: 2)
+
+		let batch = try XCTUnwrap(try res.fetchBatch(maxRows: 10))
+		XCTAssertEqual(batch.rowCount, 3)
+
+		guard case let .int64(ids) = batch.columns[0].values else { return XCTFail("Expected an integer column") }
+		XCTAssertEqual(ids, [1, 2, 3])
+
+		guard case let .string(names) = batch.columns[1].values else { return XCTFail("Expected a string column") }
+		XCTAssertEqual(names[0], "one")
+		XCTAssertTrue(batch.columns[1].isNull(at: 1))
+		XCTAssertEqual(names[2], "three")
+
+		// The storage of the first batch is refilled rather than allocated again.
+		let storage = try XCTUnwrap(res.handle.batch)
+		XCTAssertNil(try res.fetchBatch(maxRows: 10))
+		XCTAssertEqual(res.handle.batch, storage)
+	}
+
+	func testColumnNamesAndStrings() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "stringTable";
+		CREATE TABLE "stringTable" ("id" INTEGER NOT NULL, "name" VARCHAR(32));
+		INSERT INTO "stringTable" ("id", "name") VALUES (1, 'one'), (2, 'second'), (3, NULL);
+		""")
+
+		let query = "SELECT \"id\", \"name\" FROM \"stringTable\" ORDER BY \"id\";"
+		let res = try conn.execute(query: query, rowsetSize: 2)
+		let error = UnsafeMutablePointer<CError>.cErrorPointer
+
+		XCTAssertEqual(try res.name(of: 1), "name")
+		// The name is read from the result rather than copied for each call.
+		XCTAssertEqual(resultColumnName(res.resPointer, 1, error), resultColumnName(res.resPointer, 1, error))
+
+		XCTAssertTrue(try res.next())
+		XCTAssertTrue(try res.next())
+
+		// The second row of the rowset is read from the middle of the bound buffer.
+		var column: Int16 = 1
+		var data: UnsafePointer<CChar>?
+		var length: UInt = 0
+		XCTAssertTrue(resultGetStringView(res.resPointer, &column, nil, &data, &length, error))
+		let view = UnsafeRawBufferPointer(start: data, count: Int(length))
+		XCTAssertEqual(String(decoding: view, as: UTF8.self), "second")
+
+		var buffer = [CChar](repeating: 0, count: 3)
+		XCTAssertEqual(resultCopyString(res.resPointer, &column, nil, &buffer, 3, error), 6)
+		XCTAssertEqual(buffer.map { UInt8(bitPattern: $0) }, Array("sec".utf8))
+
+		// Other columns are not bound as character data, and are converted by a copy instead.
+		column = 0
+		XCTAssertFalse(resultGetStringView(res.resPointer, &column, nil, &data, &length, error))
+		XCTAssertFalse(error.pointee.isValid)
+		XCTAssertEqual(resultCopyString(res.resPointer, &column, nil, &buffer, 3, error), 1)
+		XCTAssertEqual(buffer[0], CChar(UInt8(ascii: "2")))
+		XCTAssertEqual(try res[0]!.string, "2")
+		XCTAssertEqual(try res[1]!.string, "second")
+
+		XCTAssertTrue(try res.next())
+		XCTAssertNil(try res["name"]!.string)
+	}
+
+	func testColumnRef() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "columnTable";
+		CREATE TABLE "columnTable" ("id" INTEGER NOT NULL, "name" VARCHAR(16), "score" REAL);
+		INSERT INTO "columnTable" ("id", "name", "score") VALUES (1, 'one', 1.5), (2, 'two', NULL);
+		""")
+
+		var res = try conn.execute(query: "SELECT \"id\", \"name\", \"score\" FROM \"columnTable\" ORDER BY \"id\";")
+
+		// Every column is found by name, whatever its position.
+		XCTAssertEqual(try res.index(of: "id"), 0)
+		XCTAssertEqual(try res.index(of: "name"), 1)
+		XCTAssertEqual(try res.index(of: "score"), 2)
+
+		let columns = try res.columns(named: ["score", "name"])
+		XCTAssertEqual(columns.map(\.index), [2, 1])
+		XCTAssertEqual(columns.map(\.name), ["score", "name"])
+		XCTAssertEqual(try res.column(named: "id"), Result.ColumnRef(name: "id", index: 0))
+
+		var names: [String] = []
+		var scores: [Double?] = []
+
+		while try res.next() {
+			names.append(try res[columns[1]]!.string!)
+			scores.append(try res[columns[0]]!.double)
+			XCTAssertEqual(try res[columns[1]]!.string, try res["name"]!.string)
+		}
+
+		XCTAssertEqual(names, ["one", "two"])
+		XCTAssertEqual(scores, [1.5, nil])
+
+		XCTAssertThrowsError(try res.column(named: "missing")) { error in
+			guard case .indexOutOfRange = error as? ODBCError else {
+				return XCTFail("Expected an index out of range error, got \(error)")
+			}
+		}
+		XCTAssertThrowsError(try res.columns(named: ["id", "missing"]))
+	}
+
+	func testArrowExport() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "arrowTable";
+		CREATE TABLE "arrowTable" ("id" INTEGER, "name" VARCHAR(16));
+		INSERT INTO "arrowTable" ("id", "name") VALUES (1, 'a'), (NULL, 'bcd'), (3, NULL);
+		""")
+
+		let query = "SELECT \"id\", \"name\" FROM \"arrowTable\" ORDER BY \"rowid\";"
+		let res = try conn.execute(query: query, rowsetSize: 3)
+		let error = UnsafeMutablePointer<CError>.cErrorPointer
+
+		let schemaPointer = UnsafeMutablePointer<ArrowSchema>.allocate(capacity: 1)
+		try res.exportArrowSchema(to: schemaPointer)
+		let schema = schemaPointer.pointee
+
+		defer {
+			schema.release?(schemaPointer)
+			schemaPointer.deallocate()
+		}
+
+		XCTAssertEqual(String(cString: schema.format), "+s")
+		XCTAssertEqual(schema.n_children, 2)
+
+		let idSchema = try XCTUnwrap(schema.children)[0].pointee
+		// nanodbc binds every integer column as `SQL_C_SBIGINT`.
+		XCTAssertEqual(String(cString: idSchema.format), "l")
+		XCTAssertEqual(idSchema.name.map { String(cString: $0) }, "id")
+		XCTAssertEqual(idSchema.flags, Int64(ARROW_FLAG_NULLABLE))
+
+		let nameSchema = try XCTUnwrap(schema.children)[1].pointee
+		XCTAssertEqual(String(cString: nameSchema.format), "u")
+		XCTAssertEqual(nameSchema.name.map { String(cString: $0) }, "name")
+
+		let arrayPointer = UnsafeMutablePointer<ArrowArray>.allocate(capacity: 1)
+		XCTAssertTrue(resultExportArrowBatch(res.resPointer, arrayPointer, error))
+		let array = arrayPointer.pointee
+
+		defer {
+			array.release?(arrayPointer)
+			arrayPointer.deallocate()
+		}
+
+		XCTAssertEqual(array.length, 3)
+		XCTAssertEqual(array.n_children, 2)
+
+		// The integers are handed over in the bound buffer, starting at the batch's offset into it.
+		let ids = try XCTUnwrap(array.children)[0].pointee
+		let idBuffers = try XCTUnwrap(ids.buffers)
+		XCTAssertEqual(ids.n_buffers, 2)
+		XCTAssertEqual(ids.null_count, 1)
+		let idValidity = try XCTUnwrap(idBuffers[0]).assumingMemoryBound(to: UInt8.self)
+		let idValues = try XCTUnwrap(idBuffers[1]).assumingMemoryBound(to: Int64.self)
+		let idRows = (0..<3).map { Int(ids.offset) + $0 }
+		XCTAssertEqual(idRows.map { idValidity[$0 / 8] & UInt8(1 << ($0 % 8)) != 0 }, [true, false, true])
+		XCTAssertEqual(idValues[idRows[0]], 1)
+		XCTAssertEqual(idValues[idRows[2]], 3)
+
+		// Strings are copied into offsets and values.
+		let names = try XCTUnwrap(array.children)[1].pointee
+		let nameBuffers = try XCTUnwrap(names.buffers)
+		XCTAssertEqual(names.n_buffers, 3)
+		XCTAssertEqual(names.offset, 0)
+		XCTAssertEqual(names.null_count, 1)
+		XCTAssertEqual(try XCTUnwrap(nameBuffers[0]).load(as: UInt8.self), 0b011)
+		let offsets = try XCTUnwrap(nameBuffers[1]).assumingMemoryBound(to: Int32.self)
+		XCTAssertEqual(Array(UnsafeBufferPointer(start: offsets, count: 4)), [0, 1, 4, 4])
+		let values = UnsafeRawBufferPointer(start: nameBuffers[2], count: 4)
+		XCTAssertEqual(String(decoding: values, as: UTF8.self), "abcd")
+
+		let end = UnsafeMutablePointer<ArrowArray>.allocate(capacity: 1)
+		defer { end.deallocate() }
+		XCTAssertFalse(resultExportArrowBatch(res.resPointer, end, error))
+		XCTAssertFalse(error.pointee.isValid)
+	}
+
+	func testErrorReporting() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		for _ in 0..<2 {
+			XCTAssertThrowsError(try conn.execute(query: "SELECT * FROM \"missingTable\";")) { error in
+				guard case let .databaseError(message) = error as? ODBCError else {
+					return XCTFail("Expected a database error, got \(error)")
+				}
+
+				XCTAssertTrue(message?.contains("missingTable") ?? false)
+			}
+		}
+
+		// A failure must not leak into the next call on the same thread.
+		let res = try conn.execute(query: "SELECT 1, NULL;")
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 1)
+		XCTAssertNil(try res[1]!.int)
+		XCTAssertEqual(try res[0]!.int, 1)
+	}
+
+	func testEpochMicroseconds() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "eventTable";
+		CREATE TABLE "eventTable" ("id" INTEGER NOT NULL, "at" TIMESTAMP);
+		INSERT INTO "eventTable" ("id", "at") VALUES
+			(1, '1970-01-01 00:00:00'), (2, '2022-03-04 05:06:07'), (3, NULL), (4, '1969-12-31 23:59:59');
+		""")
+
+		let res = try conn.execute(query: "SELECT \"at\" FROM \"eventTable\" ORDER BY \"id\";", rowsetSize: 3)
+		var micros: [Int64?] = []
+
+		while try res.next() {
+			micros += try res.epochMicroseconds(at: 0)
+		}
+
+		XCTAssertEqual(micros, [0, 1_646_370_367_000_000, nil, -1_000_000])
+
+		let single = try conn.execute(query: "SELECT \"at\" FROM \"eventTable\" WHERE \"id\" = 2;")
+		XCTAssertTrue(try single.next())
+		XCTAssertEqual(try single[0]!.timeStamp?.date, ODBCDate(day: 4, month: 3, year: 2022))
+	}
+
+	func testDecodable() throws {
+		struct Person: Decodable, Equatable {
+			enum Role: String, Decodable {
+				case admin, member
+			}
+
+			let id: Int
+			let name: String
+			let role: Role
+			let nickname: String?
+			let score: Double
+			let birthday: ODBCDate?
+		}
+
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "decodableTable";
+		CREATE TABLE "decodableTable" (
+			"ID" INTEGER NOT NULL, "name" VARCHAR(32) NOT NULL, "role" VARCHAR(16) NOT NULL,
+			"nickname" VARCHAR(32), "score" REAL NOT NULL, "birthday" DATE
+		);
+		INSERT INTO "decodableTable" VALUES
+			(1, 'Ada', 'admin', NULL, 9.5, '1815-12-10'), (2, 'Brian', 'member', 'B', 7, NULL);
+		""")
+
+		let expected = [
+			Person(id: 1, name: "Ada", role: .admin, nickname: nil, score: 9.5,
+			       birthday: ODBCDate(day: 10, month: 12, year: 1815)),
+			Person(id: 2, name: "Brian", role: .member, nickname: "B", score: 7, birthday: nil),
+		]
+
+		let query = "SELECT * FROM \"decodableTable\" ORDER BY \"ID\";"
+
+		XCTAssertEqual(try conn.execute(query: query, rowsetSize: 10).rows(as: Person.self, batchSize: 1), expected)
+
+		let res = try conn.execute(query: query)
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res.decode(Person.self), expected[0])
+		let plan = try res.columnPlan
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res.decode(Person.self), expected[1])
+		// The columns are resolved once for the whole result, not again for every decoded row.
+		XCTAssertTrue(try res.columnPlan === plan)
+
+		let counts = try conn.execute(query: "SELECT COUNT(*) FROM \"decodableTable\";").rows(as: Int.self)
+		XCTAssertEqual(counts, [2])
+
+		XCTAssertThrowsError(try conn.execute(query: "SELECT \"name\" FROM \"decodableTable\";").rows(as: Person.self))
+	}
+
+	func testExecuteBatch() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "executeBatchTable";
+		CREATE TABLE "executeBatchTable" ("id" INTEGER NOT NULL, "name" VARCHAR(32));
+		""")
+
+		let stmt = Statement(connection: conn, query: "INSERT INTO \"executeBatchTable\" (\"id\", \"name\") VALUES (?, ?);")
+		_ = try stmt.executeBatch(rows: [[1, "one"], [2, nil], [3, "three"]])
+		// The statement stays bound to the arrays of the batch, so executing it again without binding reads their
+		// first row from buffers that are still alive.
+		_ = try stmt.execute(with: [Int?]())
+
+		var res = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"executeBatchTable\" ORDER BY \"id\";")
+		var ids: [Int] = []
+		var names: [String?] = []
+
+		while try res.next() {
+			ids.append(try res[0]!.int!)
+			names.append(try res[1]!.string)
+		}
+
+		XCTAssertEqual(ids, [1, 1, 2, 3])
+		XCTAssertEqual(names, ["one", "one", nil, "three"])
+	}
+
+	func testStatementReexecution() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "reexecuteTable";
+		CREATE TABLE "reexecuteTable" ("id" INTEGER NOT NULL, "name" VARCHAR(32) NOT NULL);
+		""")
+
+		let stmt = Statement(connection: conn, query: "INSERT INTO \"reexecuteTable\" (\"id\", \"name\") VALUES (?, ?);")
+
+		for (id, name) in [(1, "one"), (2, "a longer name")] {
+			try stmt.bind(id, to: 0)
+			try stmt.bind(name, to: 1)
+			_ = try stmt.execute(with: [Int?]())
+		}
+
+		var res = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"reexecuteTable\" ORDER BY \"id\";")
+
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 1)
+		XCTAssertEqual(try res[1]!.string, "one")
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 2)
+		XCTAssertEqual(try res[1]!.string, "a longer name")
+	}
+
+	func testStatementCache() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+		let query = "SELECT \"id\" FROM \"testTable1\" WHERE \"id\" = ?;"
+
+		for _ in 0..<3 {
+			var res = try conn.statement(query: query).execute(with: [1])
+			XCTAssertTrue(try res.next())
+			XCTAssertEqual(try res[0]!.int, 1)
+		}
+
+		XCTAssertEqual(conn.statementCacheStatistics.misses, 1)
+		XCTAssertEqual(conn.statementCacheStatistics.hits, 2)
+
+		// A statement is only reused for the timeout it was prepared with.
+		_ = Statement(connection: conn, query: query, timeout: 5)
+		XCTAssertEqual(conn.statementCacheStatistics.misses, 2)
+		_ = Statement(connection: conn, query: query, timeout: 5)
+		XCTAssertEqual(conn.statementCacheStatistics.hits, 3)
+
+		conn.statementCacheCapacity = 0
+		XCTAssertEqual(conn.statementCacheStatistics.size, 0)
+	}
+
+	func testConnectionPool() throws {
+		let pool = try ConnectionPool(.odbcString(Self.connString), minSize: 1, maxSize: 2, validationQuery: "SELECT 1;")
+		XCTAssertEqual(pool.size, 1)
+
+		for _ in 0..<3 {
+			try pool.withConnection { conn in
+				var res = try conn.execute(query: "SELECT \"id\" FROM \"testTable1\";")
+				XCTAssertTrue(try res.next())
+			}
+		}
+
+		XCTAssertEqual(pool.size, 1)
+		XCTAssertEqual(pool.idleCount, 1)
+	}
+
+	func testPoolConnectionCloses() throws {
+		let conn = try Connection(.odbcString(Self.connString + "Timeout=100;"))
+		try conn.justExecute(query: "DROP TABLE IF EXISTS \"lockTable\";")
+		try conn.justExecute(query: "CREATE TABLE \"lockTable\" (\"id\" INTEGER);")
+		try conn.justExecute(query: "INSERT INTO \"lockTable\" VALUES (1), (2), (3);")
+
+		do {
+			let pool = try ConnectionPool(.odbcString(Self.connString), maxSize: 1)
+			let res = try pool.acquire().execute(query: "SELECT \"id\" FROM \"lockTable\";")
+			XCTAssertTrue(try res.next())
+			XCTAssertEqual(pool.idleCount, 0)
+		}
+
+		// A statement left open with rows still to read would hold SQLite's read lock, and dropping the table would
+		// fail with "database is locked".
+		try conn.justExecute(query: "DROP TABLE \"lockTable\";")
+	}
+
+	func testDecimal() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "decimalTable";
+		CREATE TABLE "decimalTable" ("id" INTEGER NOT NULL, "amount" VARCHAR(64));
+		""")
+
+		let amount = try XCTUnwrap(ODBCDecimal("-12345678901234567890.1234"))
+		XCTAssertEqual(amount.scale, 4)
+		XCTAssertEqual(ODBCDecimal("1.50"), ODBCDecimal(significand: 15, scale: 1))
+
+		let stmt = Statement(connection: conn, query: "INSERT INTO \"decimalTable\" (\"id\", \"amount\") VALUES (?, ?);")
+		_ = try stmt.executeBatch(rows: [[1, amount], [2, nil]])
+
+		var res = try conn.execute(query: "SELECT \"amount\" FROM \"decimalTable\" ORDER BY \"id\";")
+
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.decimal, amount)
+		XCTAssertEqual(try res[0]!.decimal?.description, "-12345678901234567890.1234")
+		XCTAssertEqual(try res[0]!.double, -12345678901234567890.1234)
+
+		XCTAssertTrue(try res.next())
+		XCTAssertNil(try res[0]!.decimal)
+	}
+
+	func testBlob() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "blobTable";
+		CREATE TABLE "blobTable" ("id" INTEGER NOT NULL, "data" BLOB);
+		""")
+
+		let data = (0..<100_000).map { UInt8(truncatingIfNeeded: $0 &* 31) }
+		let stmt = Statement(connection: conn, query: "INSERT INTO \"blobTable\" (\"id\", \"data\") VALUES (?, ?);")
+		_ = try stmt.executeBatch(rows: [[1, data], [2, nil]])
+
+		let res = try conn.execute(query: "SELECT \"data\" FROM \"blobTable\" ORDER BY \"id\";")
+
+		XCTAssertTrue(try res.next())
+		let blob = try res.blob(at: 0, chunkSize: 4096)
+		var read: [UInt8] = []
+
+		while let chunk = try blob.readChunk() {
+			XCTAssertLessThanOrEqual(chunk.count, 4096)
+			read += chunk
+		}
+
+		XCTAssertFalse(blob.isNull)
+		XCTAssertEqual(read, data)
+
+		XCTAssertTrue(try res.next())
+		let nullBlob = try res.blob(named: "data")
+		XCTAssertNil(try nullBlob.readChunk())
+		XCTAssertTrue(nullBlob.isNull)
+	}
+
+	@available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
+	func testAsyncExecution() async throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try await conn.justExecuteAsync(query: """
+		DROP TABLE IF EXISTS "asyncTable";
+		CREATE TABLE "asyncTable" ("id" INTEGER NOT NULL);
+		INSERT INTO "asyncTable" ("id") VALUES (1), (2), (3);
+		""")
+
+		let query = "SELECT \"id\" FROM \"asyncTable\" ORDER BY \"id\";"
+		let res = try await conn.executeAsync(query: query, rowsetSize: 2)
+		var ids: [Int] = []
+
+		while try await res.nextAsync() {
+			ids.append(try res[0]!.int!)
+		}
+
+		XCTAssertEqual(ids, [1, 2, 3])
+
+		// The blocking variants stay usable from asynchronous code.
+		let blocking = try conn.execute(query: "SELECT COUNT(*) FROM \"asyncTable\";")
+		XCTAssertTrue(try blocking.next())
+		XCTAssertEqual(try blocking[0]!.int, 3)
+
+		let stmt = Statement(connection: conn, query: "SELECT \"id\" FROM \"asyncTable\" WHERE \"id\" = ?;")
+		let filtered = try await stmt.executeAsync(with: [2])
+		XCTAssertTrue(try await filtered.nextAsync())
+		XCTAssertEqual(try filtered[0]!.int, 2)
+
+		do {
+			_ = try await conn.executeAsync(query: "SELECT * FROM \"missingTable\";")
+			XCTFail("Expected an error")
+		} catch {
+			guard case .databaseError = error as? ODBCError else {
+				return XCTFail("Expected a database error, got \(error)")
+			}
+		}
+	}
+
+	func testPrefetchBatches() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "prefetchTable";
+		CREATE TABLE "prefetchTable" ("id" INTEGER NOT NULL);
+		""")
+
+		let stmt = Statement(connection: conn, query: "INSERT INTO \"prefetchTable\" (\"id\") VALUES (?);")
+		_ = try stmt.executeBatch(rows: (0..<2500).map { [$0] })
+
+		let res = try conn.execute(query: "SELECT \"id\" FROM \"prefetchTable\" ORDER BY \"id\";", rowsetSize: 1000)
+		let batches = try res.prefetchBatches(maxRows: 1000)
+		var ids: [Int64] = []
+
+		while let batch = try batches.next() {
+			guard case let .int64(values) = batch.columns[0].values else { return XCTFail("Expected integers") }
+			ids += values
+		}
+
+		XCTAssertEqual(ids, (0..<2500).map(Int64.init))
+		XCTAssertNil(try batches.next())
+	}
+
+	func testPartitionedQuery() throws {
+		let pool = try ConnectionPool(.odbcString(Self.connString), maxSize: 4)
+
+		try pool.withConnection { conn in
+			try conn.justExecute(query: """
+			DROP TABLE IF EXISTS "partitionTable";
+			CREATE TABLE "partitionTable" ("id" INTEGER NOT NULL);
+			""")
+
+			let stmt = Statement(connection: conn, query: "INSERT INTO \"partitionTable\" (\"id\") VALUES (?);")
+			_ = try stmt.executeBatch(rows: (0..<1000).map { [$0] })
+		}
+
+		// Each query holds its connections until its batches are deinitialized, so they run in their own scope.
+		do {
+			let batches = try pool.executePartitioned(
+				query: "SELECT \"id\" FROM \"partitionTable\" WHERE \"id\" >= ? AND \"id\" < ?;",
+				keyRange: 0..<1000,
+				partitions: 4,
+				batchSize: 100
+			)
+			var ids: [Int64] = []
+
+			while let batch = try batches.next() {
+				guard case let .int64(values) = batch.columns[0].values else { return XCTFail("Expected integers") }
+				ids += values
+			}
+
+			XCTAssertEqual(ids.sorted(), (0..<1000).map(Int64.init))
+		}
+
+		// The pool could never hand out a connection for every partition.
+		XCTAssertThrowsError(
+			try pool.executePartitioned(query: "SELECT 1;", partitions: Array(repeating: [BindableValue?](), count: 5))
+		)
+
+		// A range wider than `Int64.max` is split without overflowing.
+		do {
+			let batches = try pool.executePartitioned(
+				query: "SELECT \"id\" FROM \"partitionTable\" WHERE \"id\" >= ? AND \"id\" < ?;",
+				keyRange: Int64.min..<Int64.max,
+				partitions: 2
+			)
+			var rowCount = 0
+
+			while let batch = try batches.next() {
+				rowCount += batch.rowCount
+			}
+
+			XCTAssertEqual(rowCount, 1000)
+		}
+	}
+
+	func testTransactions() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "transactionTable";
+		CREATE TABLE "transactionTable" ("id" INTEGER NOT NULL);
+		""")
+
+		func count() throws -> Int {
+			let res = try conn.execute(query: "SELECT COUNT(*) FROM \"transactionTable\";")
+			XCTAssertTrue(try res.next())
+			return try res[0]!.int!
+		}
+
+		do {
+			let rolledBack = try conn.beginTransaction()
+			try conn.justExecute(query: "INSERT INTO \"transactionTable\" (\"id\") VALUES (1);")
+			rolledBack.rollback()
+			XCTAssertThrowsError(try rolledBack.commit())
+		}
+
+		XCTAssertEqual(try count(), 0)
+
+		try conn.withTransaction { conn in
+			try conn.justExecute(query: "INSERT INTO \"transactionTable\" (\"id\") VALUES (1);")
+			try conn.withTransaction { conn in
+				try conn.justExecute(query: "INSERT INTO \"transactionTable\" (\"id\") VALUES (2);")
+			}
+		}
+
+		XCTAssertEqual(try count(), 2)
+
+		let batcher = try conn.batchingCommits(every: 2)
+		XCTAssertFalse(try batcher.didExecute())
+		XCTAssertTrue(try batcher.didExecute())
+
+		for id in 3...7 {
+			try batcher.execute(query: "INSERT INTO \"transactionTable\" (\"id\") VALUES (\(id));")
+		}
+
+		try batcher.finish()
+		XCTAssertEqual(try count(), 7)
+	}
+
+	func testBulkInsert() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "bulkTable";
+		CREATE TABLE "bulkTable" ("id" INTEGER NOT NULL, "name" VARCHAR(64));
+		""")
+
+		let report = try conn.bulkInsert(
+			table: "bulkTable",
+			columns: ["id", "name"],
+			rows: (0..<2500).lazy.map { id -> [BindableValue?] in [id, id.isMultiple(of: 2) ? "row \(id)" : nil] },
+			batchSize: 1000
+		)
+
+		XCTAssertEqual(report.insertedRows, 2500)
+		XCTAssertEqual(report.batches, 3)
+		XCTAssertEqual(report.failedRows, [])
+
+		let res = try conn.execute(query: "SELECT COUNT(*), COUNT(\"name\") FROM \"bulkTable\";")
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 2500)
+		XCTAssertEqual(try res[1]!.int, 1250)
+
+		XCTAssertThrowsError(try conn.bulkInsert(table: "bulkTable", columns: ["id", "name"], rows: [[1]]))
+	}
+
+	func testRowSequence() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		try conn.justExecute(query: """
+		DROP TABLE IF EXISTS "rowTable";
+		CREATE TABLE "rowTable" ("id" INTEGER NOT NULL, "name" VARCHAR(64));
+		INSERT INTO "rowTable" ("id", "name") VALUES (1, 'one'), (2, NULL), (3, 'three');
+		""")
+
+		let res = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"rowTable\" ORDER BY \"id\";")
+		var rows = res.rows(batchSize: 2)
+
+		let first = try XCTUnwrap(rows.next())
+		XCTAssertEqual(first[0].int, 1)
+		XCTAssertEqual(first["NAME"]?.string, "one")
+		XCTAssertNil(first["missing"])
+
+		// The second row comes from the batch already fetched, the third from the next one.
+		var ids: [Int] = []
+		var names: [String?] = []
+
+		while let row = try rows.next() {
+			ids.append(row[0].int!)
+			names.append(row["name"]?.string)
+		}
+
+		XCTAssertEqual(ids, [2, 3])
+		XCTAssertEqual(names, [nil, "three"])
+		// A row stays readable after the result has moved past it.
+		XCTAssertEqual(first[0].int, 1)
+		XCTAssertNil(try rows.next())
+		XCTAssertFalse(try res.next())
+
+		struct Named: Decodable {
+			let id: Int
+			let name: String?
+		}
+
+		var decoded: [Named] = []
+		var named = try conn.execute(query: "SELECT \"id\", \"name\" FROM \"rowTable\" ORDER BY \"id\";").rows()
+
+		while let row = try named.next() {
+			decoded.append(try row.decode(Named.self))
+		}
+
+		XCTAssertEqual(decoded.map(\.id), [1, 2, 3])
+		XCTAssertNil(decoded[1].name)
+	}
+
+	func testRowIteratorThrows() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+		// SQLite only overflows when it steps to the second row, which happens while fetching.
+		let res = try conn.execute(query: """
+		SELECT abs("x") FROM (SELECT 1 AS "x" UNION ALL SELECT -9223372036854775808);
+		""")
+		var rows = res.rows(batchSize: 1)
+
+		XCTAssertEqual(try rows.next()?[0].int, 1)
+		// The error is thrown rather than ending the iteration as if the result had run out of rows.
+		XCTAssertThrowsError(try rows.next())
+	}
+
+	func testNextResultSet() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+
+		// The SQLite driver returns a single result set per execution, which ends the sequence of result sets.
+		let res = try conn.execute(query: "SELECT 1 AS \"first\", 'two' AS \"second\";")
+
+		XCTAssertTrue(try res.next())
+		XCTAssertEqual(try res[0]!.int, 1)
+		XCTAssertFalse(try res.next())
+		XCTAssertFalse(try res.nextResultSet())
+	}
+
+	func testMetadataCache() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+		let catalog = Catalog(connection: conn)
+
+		try conn.justExecute(query: "DROP TABLE IF EXISTS \"cachedTable\";")
+		try conn.justExecute(query: "CREATE TABLE \"cachedTable\" (\"id\" INTEGER NOT NULL, \"name\" TEXT);")
+
+		conn.metadataCacheTTL = 60
+
+		let columns = try catalog.columns(table: "cachedTable")
+		XCTAssertEqual(columns.map(\.name), ["id", "name"])
+		XCTAssertEqual(columns.map(\.ordinalPosition), [1, 2])
+		XCTAssertEqual(try catalog.columns(table: "cachedTable").map(\.name), ["id", "name"])
+		XCTAssertEqual(conn.metadataCacheStatistics.hits, 1)
+
+		// Cached lookups do not see the new column until they are invalidated.
+		try conn.justExecute(query: "ALTER TABLE \"cachedTable\" ADD COLUMN \"extra\" REAL;")
+		XCTAssertEqual(try catalog.columns(table: "cachedTable").count, 2)
+
+		conn.invalidateMetadataCache(table: "cachedTable")
+		XCTAssertEqual(try catalog.columns(table: "cachedTable").map(\.name), ["id", "name", "extra"])
+		XCTAssertEqual(conn.metadataCacheStatistics.misses, 2)
+
+		conn.metadataCacheTTL = 0
+		XCTAssertEqual(conn.metadataCacheStatistics.size, 0)
+	}
+
+	func testCatalogTables() throws {
+		let conn = try Connection(.odbcString(Self.connString))
+		let catalog = Catalog(connection: conn)
+
+		try conn.justExecute(query: "DROP TABLE IF EXISTS \"keyedTable\";")
+		try conn.justExecute(
+			query: "CREATE TABLE \"keyedTable\" (\"a\" INTEGER, \"b\" TEXT, \"c\" REAL, PRIMARY KEY (\"a\", \"b\"));"
+		)
+
+		let tables = try catalog.tables(table: "keyedTable", types: "TABLE")
+		XCTAssertEqual(tables.map(\.tableName), ["keyedTable"])
+		XCTAssertEqual(tables.first?.tableType, "TABLE")
+
+		let keys = try catalog.primaryKeys(table: "keyedTable")
+		XCTAssertEqual(keys.map(\.columnName), ["a", "b"])
+		XCTAssertEqual(keys.map(\.columnNumber), [1, 2])
+
+		XCTAssertTrue(try catalog.tables(table: "missingTable").isEmpty)
+	}
 }
@@ -0,0 +1,99 @@
+// Copyright (c) 2022 Jeff Lebrun
+//
+//  Licensed under the MIT License.
+//
+//  The full text of the license can be found in the file named LICENSE.
+
+import CNanODBC
+import XCTest
+
+final class TranscodeTests: XCTestCase {
+	static let implementations: [(String, TranscodeImplementation)] = [
+		("best", .bestTranscoder),
+		("scalar", .scalarTranscoder),
+		("codecvt", .codecvtTranscoder),
+	]
+
+	/// Long enough for the SIMD implementations to take their vector paths before and after the text.
+	static let padding = String(repeating: "a", count: 40)
+
+	static let texts = [
+		"",
+		"hello",
+		"é",
+		"€",
+		"😀",
+		"aé€😀",
+		padding + "é€😀" + padding,
+	]
+
+	func utf16ToUTF8(_ units: [UInt16], _ implementation: TranscodeImplementation) -> [UInt8]? {
+		var out = [CChar](repeating: 0, count: max(3 * units.count, 1))
+		let count = transcodeUTF16ToUTF8(units, UInt(units.count), &out, implementation)
+
+		return count < 0 ? nil : out[0..<count].map { UInt8(bitPattern: $0) }
+	}
+
+	func utf8ToUTF16(_ bytes: [UInt8], _ implementation: TranscodeImplementation) -> [UInt16]? {
+		var out = [UInt16](repeating: 0, count: max(bytes.count, 1))
+		let count = transcodeUTF8ToUTF16(bytes.map { CChar(bitPattern: $0) }, UInt(bytes.count), &out, implementation)
+
+		return count < 0 ? nil : Array(out[0..<count])
+	}
+
+	func testRoundTrip() {
+		for (name, implementation) in Self.implementations {
+			for text in Self.texts {
+				let units = Array(text.utf16)
+				let bytes = Array(text.utf8)
+
+				XCTAssertEqual(utf16ToUTF8(units, implementation), bytes, "\(name): \(text)")
+				XCTAssertEqual(utf8ToUTF16(bytes, implementation), units, "\(name): \(text)")
+				XCTAssertEqual(utf8ToUTF16(utf16ToUTF8(units, implementation) ?? [], implementation), units, name)
+			}
+		}
+	}
+
+	func testLoneSurrogates() {
+		let padding = Array(Self.padding.utf16)
+		let inputs: [[UInt16]] = [
+			[0xD83D],
+			[0x61, 0xD83D, 0x62],
+			[0x61, 0xDE00],
+			[0xDE00, 0xD83D],
+			padding + [0xDE00] + padding,
+			padding + [0xD83D],
+		]
+
+		for (name, implementation) in Self.implementations {
+			for input in inputs {
+				XCTAssertNil(utf16ToUTF8(input, implementation), "\(name): \(input)")
+			}
+		}
+	}
+
+	func testInvalidUTF8() {
+		let padding = Array(Self.padding.utf8)
+		let inputs: [[UInt8]] = [
+			// A stray continuation byte.
+			[0x80],
+			// An overlong encoding of U+0000.
+			[0xC0, 0x80],
+			// A sequence cut short, at the end of the input and before more text.
+			[0xE2, 0x82],
+			[0xE2, 0x82, 0x61],
+			padding + [0xF0, 0x9F, 0x98],
+			// A surrogate encoded as UTF-8.
+			[0xED, 0xA0, 0x80],
+			// A code point above U+10FFFF.
+			[0xF4, 0x90, 0x80, 0x80],
+			padding + [0x80] + padding,
+		]
+
+		for (name, implementation) in Self.implementations {
+			for input in inputs {
+				XCTAssertNil(utf8ToUTF16(input, implementation), "\(name): \(input)")
+			}
+		}
+	}
+}